@@ -0,0 +1,721 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <list>
+#include <mutex>
+#include <memory_resource>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "cached_set.h"
+#include "filtered_set.h"
+#include "list.h"
+#include "multiset.h"
+#include "queue.h"
+#include "reclaimer.h"
+#include "set.h"
+#include "set_views.h"
+#include "sharded_set.h"
+#include "spsc_queue.h"
+#include "static_set.h"
+#include "unordered_set.h"
+
+#ifndef S21_BENCH_MAX_N
+#define S21_BENCH_MAX_N 1000000
+#endif
+
+namespace {
+template <typename Key>
+Key MakeKey(uint64_t i);
+
+template <>
+int MakeKey<int>(uint64_t i) {
+  return static_cast<int>(i);
+}
+
+template <>
+uint64_t MakeKey<uint64_t>(uint64_t i) {
+  return i;
+}
+
+// zero padded so that the string order follows the numeric one
+template <>
+std::string MakeKey<std::string>(uint64_t i) {
+  char buf[24];
+  std::snprintf(buf, sizeof(buf), "key%016llu",
+                static_cast<unsigned long long>(i));
+  return buf;
+}
+
+// even numbers are stored, odd ones are used for misses
+template <typename Key>
+std::vector<Key> Keys(size_t n, bool shuffled, uint64_t distinct = 0,
+                      bool miss = false) {
+  std::vector<uint64_t> ids(n);
+  std::iota(ids.begin(), ids.end(), 0);
+  std::mt19937_64 gen(n + miss);
+  if (distinct) {
+    for (auto &id : ids) id = gen() % distinct;
+  } else if (shuffled) {
+    std::shuffle(ids.begin(), ids.end(), gen);
+  }
+
+  std::vector<Key> keys;
+  keys.reserve(n);
+  for (uint64_t id : ids) keys.push_back(MakeKey<Key>(2 * id + miss));
+  return keys;
+}
+
+template <typename Container>
+Container Build(const std::vector<typename Container::key_type> &keys) {
+  Container c;
+  for (const auto &key : keys) c.insert(key);
+  return c;
+}
+
+template <typename Container>
+void BM_InsertRandom(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  for (auto _ : state) {
+    Container c = Build<Container>(keys);
+    benchmark::DoNotOptimize(c);
+    state.PauseTiming();
+    c.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Container>
+void BM_InsertSorted(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), false);
+  for (auto _ : state) {
+    Container c = Build<Container>(keys);
+    benchmark::DoNotOptimize(c);
+    state.PauseTiming();
+    c.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// every key repeats about 16 times
+template <typename Container>
+void BM_InsertDuplicates(benchmark::State &state) {
+  size_t n = state.range(0);
+  auto keys = Keys<typename Container::key_type>(n, true, n / 16 + 1);
+  for (auto _ : state) {
+    Container c = Build<Container>(keys);
+    benchmark::DoNotOptimize(c);
+    state.PauseTiming();
+    c.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Container>
+void BM_FindHit(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  Container c = Build<Container>(keys);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937_64(1));
+  for (auto _ : state) {
+    for (const auto &key : keys) benchmark::DoNotOptimize(c.find(key));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Container>
+void BM_FindMiss(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  Container c = Build<Container>(keys);
+  auto misses =
+      Keys<typename Container::key_type>(keys.size(), true, 0, true);
+  for (auto _ : state) {
+    for (const auto &key : misses) benchmark::DoNotOptimize(c.contains(key));
+  }
+  state.SetItemsProcessed(state.iterations() * misses.size());
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  Container c = Build<Container>(keys);
+  for (auto _ : state) {
+    for (auto it = c.begin(); it != c.end(); ++it) {
+      benchmark::DoNotOptimize(*it);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Container>
+void BM_Erase(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  std::vector<typename Container::key_type> order = keys;
+  std::shuffle(order.begin(), order.end(), std::mt19937_64(2));
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c = Build<Container>(keys);
+    state.ResumeTiming();
+    for (const auto &key : order) c.erase(c.find(key));
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// two thirds of the source keys are already in the destination
+template <typename Container>
+void BM_Merge(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  std::vector<typename Container::key_type> dst_keys(
+      keys.begin(), keys.begin() + keys.size() * 3 / 4);
+  std::vector<typename Container::key_type> src_keys(
+      keys.begin() + keys.size() / 4, keys.end());
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container dst = Build<Container>(dst_keys);
+    Container src = Build<Container>(src_keys);
+    state.ResumeTiming();
+    dst.merge(src);
+    benchmark::DoNotOptimize(dst);
+  }
+  state.SetItemsProcessed(state.iterations() * src_keys.size());
+}
+
+template <typename Container>
+void BM_Copy(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  Container c = Build<Container>(keys);
+  for (auto _ : state) {
+    Container copy(c);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Container>
+void BM_Clear(benchmark::State &state) {
+  auto keys = Keys<typename Container::key_type>(state.range(0), true);
+  for (auto _ : state) {
+    state.PauseTiming();
+    Container c = Build<Container>(keys);
+    state.ResumeTiming();
+    c.clear();
+    benchmark::DoNotOptimize(c);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// 64k random hits on a set of range(0) keys, looked up one by one when
+// Width is 0 and through lookup_many with Width lookups in flight otherwise
+template <size_t Width>
+void BM_LookupMany(benchmark::State &state) {
+  auto keys = Keys<int>(state.range(0), true);
+  auto c = Build<s21::set<int>>(keys);
+  std::mt19937_64 gen(7);
+  std::vector<int> probes(1 << 16);
+  for (int &key : probes) key = keys[gen() % keys.size()];
+  for (auto _ : state) {
+    if constexpr (Width == 0) {
+      for (int key : probes) {
+        benchmark::DoNotOptimize(std::as_const(c).find(key));
+      }
+    } else {
+      benchmark::DoNotOptimize(c.lookup_many(probes, Width));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * probes.size());
+}
+
+// one tree behind one lock, what sharded_set is measured against
+struct LockedSet {
+  std::mutex mutex;
+  s21::set<int> keys;
+
+  bool insert(int key) {
+    std::lock_guard lock(mutex);
+    return keys.insert(key).second;
+  }
+};
+
+// range(0) shuffled keys inserted by range(1) writer threads, each taking
+// every range(1)-th key
+template <typename Container>
+void BM_ConcurrentInsert(benchmark::State &state) {
+  auto keys = Keys<int>(state.range(0), true);
+  size_t writers = state.range(1);
+  for (auto _ : state) {
+    Container c;
+    std::vector<std::jthread> pool;
+    for (size_t t = 0; t < writers; ++t) {
+      pool.emplace_back([&, t] {
+        for (size_t i = t; i < keys.size(); i += writers) c.insert(keys[i]);
+      });
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// range(0) shuffled keys in one insert_bulk call on range(1) threads
+void BM_ShardedBulkInsert(benchmark::State &state) {
+  auto keys = Keys<int>(state.range(0), true);
+  for (auto _ : state) {
+    s21::sharded_set<int, 16> c;
+    benchmark::DoNotOptimize(c.insert_bulk(keys, state.range(1)));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// a per-request scratch set: build from range(0) keys, probe every key once,
+// drop it; with Arena the nodes come from a monotonic buffer that is
+// released after each round
+template <typename Container, bool Arena>
+void BM_ScratchSet(benchmark::State &state) {
+  auto keys = Keys<int>(state.range(0), true);
+  std::pmr::monotonic_buffer_resource arena;
+  for (auto _ : state) {
+    {
+      Container c = [&] {
+        if constexpr (Arena) {
+          return Container(&arena);
+        } else {
+          return Container();
+        }
+      }();
+      for (int key : keys) c.insert(key);
+      for (int key : keys) benchmark::DoNotOptimize(c.find(key));
+    }
+    arena.release();
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// how long clear() of a set of range(0) keys blocks the caller: in place,
+// or handed to a reclaimer on a thread of its own. The set is refilled
+// before every round, so the round count is fixed
+template <bool Reclaimed>
+void BM_ClearLatency(benchmark::State &state) {
+  auto keys = Keys<int>(state.range(0), true);
+  s21::reclaimer background;
+  s21::set<int> s;
+  if constexpr (Reclaimed) s.reclaim_with(&background);
+  for (auto _ : state) {
+    state.PauseTiming();
+    background.wait();
+    for (int key : keys) s.insert(key);
+    state.ResumeTiming();
+    s.clear();
+  }
+  background.wait();
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// LRU churn: every step evicts the oldest entry and appends a new one
+template <typename List>
+void BM_ListChurn(benchmark::State &state) {
+  List l;
+  for (int64_t i = 0; i < state.range(0); ++i) l.push_back(i);
+  uint64_t next = state.range(0);
+  for (auto _ : state) {
+    l.pop_front();
+    l.push_back(next++);
+    benchmark::DoNotOptimize(l.back());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename List>
+void BM_ListSort(benchmark::State &state) {
+  auto keys = Keys<uint64_t>(state.range(0), true);
+  for (auto _ : state) {
+    state.PauseTiming();
+    List l;
+    for (uint64_t key : keys) l.push_back(key);
+    state.ResumeTiming();
+    l.sort();
+    benchmark::DoNotOptimize(l.front());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// steady-state traffic: one push and one pop per step at a fixed size
+template <typename Queue>
+void BM_QueueChurn(benchmark::State &state) {
+  Queue q;
+  for (int64_t i = 0; i < state.range(0); ++i) q.push(i);
+  uint64_t next = state.range(0);
+  for (auto _ : state) {
+    q.pop();
+    q.push(next++);
+    benchmark::DoNotOptimize(q.front());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// items through one producer and one consumer thread, range(0) is the
+// queue capacity
+void BM_SpscThroughput(benchmark::State &state) {
+  const uint64_t batch = 1 << 20;
+  for (auto _ : state) {
+    s21::spsc_queue<uint64_t> q(state.range(0));
+    std::thread producer([&q] {
+      for (uint64_t i = 0; i < batch; ++i) {
+        while (!q.try_push(i)) std::this_thread::yield();
+      }
+    });
+    uint64_t sum = 0;
+    uint64_t value;
+    for (uint64_t got = 0; got < batch;) {
+      if (q.try_pop(value)) {
+        sum += value;
+        ++got;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+
+// lookups that drift through the keys in small random steps; with Finger
+// each one starts from the previous answer
+template <typename Container, bool Finger>
+void BM_FindClustered(benchmark::State &state) {
+  using Key = typename Container::key_type;
+  size_t n = state.range(0);
+  Container c = Build<Container>(Keys<Key>(n, true));
+  std::vector<Key> stream;
+  stream.reserve(n);
+  std::mt19937_64 gen(3);
+  int64_t pos = n / 2;
+  for (size_t i = 0; i < n; ++i) {
+    pos = std::clamp<int64_t>(pos + static_cast<int64_t>(gen() % 17) - 8, 0,
+                              n - 1);
+    stream.push_back(MakeKey<Key>(2 * pos));
+  }
+  for (auto _ : state) {
+    auto it = c.begin();
+    for (const auto &key : stream) {
+      if constexpr (Finger) {
+        it = c.find_from(it, key);
+      } else {
+        it = c.find(key);
+      }
+      benchmark::DoNotOptimize(it);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+// contains over range(0) keys where four lookups in five miss; Frozen
+// switches a filtered_set to its xor filter before timing
+template <typename Container, bool Frozen = false>
+void BM_ContainsMostlyMiss(benchmark::State &state) {
+  size_t n = state.range(0);
+  auto keys = Keys<int>(n, true);
+  Container c = Build<Container>(keys);
+  if constexpr (Frozen) c.freeze();
+  auto misses = Keys<int>(n, true, 0, true);
+  std::vector<int> stream;
+  for (size_t i = 0; i < n; ++i) {
+    stream.push_back(i % 5 ? misses[i] : keys[i]);
+  }
+  for (auto _ : state) {
+    for (int key : stream) benchmark::DoNotOptimize(c.contains(key));
+  }
+  state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+// Zipf(1.2) distributed lookups over range(0) keys: with 1M keys the
+// hottest 1% of them take about 90% of the traffic. Ranks are shuffled so
+// the hot keys are spread over the whole tree.
+template <typename Container>
+void BM_FindZipf(benchmark::State &state) {
+  size_t n = state.range(0);
+  auto keys = Keys<int>(n, true);
+  Container c = Build<Container>(keys);
+  std::vector<double> cdf(n);
+  double total = 0;
+  for (size_t i = 0; i < n; ++i) {
+    total += std::pow(static_cast<double>(i + 1), -1.2);
+    cdf[i] = total;
+  }
+  std::mt19937_64 gen(5);
+  std::uniform_real_distribution<double> uniform(0, total);
+  std::vector<int> stream(1 << 20);
+  for (auto &key : stream) {
+    size_t rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(gen)) -
+                  cdf.begin();
+    key = keys[std::min(rank, n - 1)];
+  }
+  for (auto _ : state) {
+    for (int key : stream) benchmark::DoNotOptimize(c.find(key));
+  }
+  state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+// membership tests against a table of N odd keys fixed at compile time,
+// half of them hits; the static_set is built by the compiler, the trees
+// before the timed loop
+constexpr int kTableStride = 7919;
+
+template <size_t N>
+constexpr std::array<int, N> TableKeys() {
+  std::array<int, N> keys{};
+  for (size_t i = 0; i < N; ++i) {
+    keys[i] = static_cast<int>(i * kTableStride % N * 2 + 1);
+  }
+  return keys;
+}
+
+template <typename Container, size_t N>
+void BM_StaticTable(benchmark::State &state) {
+  static constexpr std::array<int, N> keys = TableKeys<N>();
+  const Container c = [] {
+    if constexpr (std::is_same_v<Container, s21::static_set<int, N>>) {
+      constexpr Container table(keys);
+      return table;
+    } else {
+      return Build<Container>(std::vector<int>(keys.begin(), keys.end()));
+    }
+  }();
+  std::vector<int> stream(4096);
+  std::mt19937 gen(11);
+  for (int &key : stream) key = gen() % (2 * N);
+  for (auto _ : state) {
+    for (int key : stream) benchmark::DoNotOptimize(c.contains(key));
+  }
+  state.SetItemsProcessed(state.iterations() * stream.size());
+}
+
+// 1000 keys intersected with range(0) keys, spread over the same span
+template <bool Lazy>
+void BM_IntersectSkewed(benchmark::State &state) {
+  auto big_keys = Keys<int>(state.range(0), true);
+  std::vector<int> small_keys;
+  for (size_t i = 0; i < big_keys.size(); i += big_keys.size() / 1000) {
+    small_keys.push_back(static_cast<int>(i));
+  }
+  auto small = Build<s21::set<int>>(small_keys);
+  auto big = Build<s21::set<int>>(big_keys);
+  auto std_small = Build<std::set<int>>(small_keys);
+  auto std_big = Build<std::set<int>>(big_keys);
+  for (auto _ : state) {
+    size_t n = 0;
+    if constexpr (Lazy) {
+      for (int key : s21::intersection_view(small, big)) n += key & 1;
+    } else {
+      std::vector<int> out;
+      std::set_intersection(std_small.begin(), std_small.end(),
+                            std_big.begin(), std_big.end(),
+                            std::back_inserter(out));
+      for (int key : out) n += key & 1;
+    }
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetItemsProcessed(state.iterations() * small_keys.size());
+}
+
+void Sizes(benchmark::internal::Benchmark *b) {
+  for (int64_t n = 1000; n <= S21_BENCH_MAX_N; n *= 10) b->Arg(n);
+}
+
+template <typename Container>
+void RegisterSuite(const std::string &name) {
+  using Fn = void (*)(benchmark::State &);
+  const std::pair<const char *, Fn> cases[] = {
+      {"InsertRandom", BM_InsertRandom<Container>},
+      {"InsertSorted", BM_InsertSorted<Container>},
+      {"InsertDuplicates", BM_InsertDuplicates<Container>},
+      {"FindHit", BM_FindHit<Container>},
+      {"FindMiss", BM_FindMiss<Container>},
+      {"Iterate", BM_Iterate<Container>},
+      {"Erase", BM_Erase<Container>},
+      {"Merge", BM_Merge<Container>},
+      {"Copy", BM_Copy<Container>},
+      {"Clear", BM_Clear<Container>},
+  };
+  for (const auto &[op, fn] : cases) {
+    benchmark::RegisterBenchmark((name + "/" + op).c_str(), fn)
+        ->Apply(Sizes)
+        ->Unit(benchmark::kMicrosecond);
+  }
+}
+
+template <typename Key>
+void RegisterKey(const std::string &key) {
+  RegisterSuite<s21::set<Key>>("s21::set<" + key + ">");
+  RegisterSuite<std::set<Key>>("std::set<" + key + ">");
+  RegisterSuite<s21::multiset<Key>>("s21::multiset<" + key + ">");
+  RegisterSuite<std::multiset<Key>>("std::multiset<" + key + ">");
+  RegisterSuite<s21::unordered_set<Key>>("s21::unordered_set<" + key + ">");
+  RegisterSuite<std::unordered_set<Key>>("std::unordered_set<" + key + ">");
+}
+
+template <typename Key>
+void RegisterClustered(const std::string &key) {
+  benchmark::RegisterBenchmark(("s21::set<" + key + ">/FindClustered").c_str(),
+                               BM_FindClustered<s21::set<Key>, false>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark(
+      ("s21::set<" + key + ">/FindFromClustered").c_str(),
+      BM_FindClustered<s21::set<Key>, true>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark(("std::set<" + key + ">/FindClustered").c_str(),
+                               BM_FindClustered<std::set<Key>, false>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMicrosecond);
+}
+
+template <typename List>
+void RegisterList(const std::string &name) {
+  benchmark::RegisterBenchmark((name + "/Churn").c_str(), BM_ListChurn<List>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark((name + "/Sort").c_str(), BM_ListSort<List>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMicrosecond);
+}
+}  // namespace
+
+int main(int argc, char **argv) {
+  RegisterKey<int>("int");
+  RegisterKey<uint64_t>("uint64_t");
+  RegisterKey<std::string>("string");
+  RegisterList<s21::list<uint64_t>>("s21::list<uint64_t>");
+  RegisterList<std::list<uint64_t>>("std::list<uint64_t>");
+  RegisterClustered<int>("int");
+  RegisterClustered<std::string>("string");
+  benchmark::RegisterBenchmark("s21::set<int>/LookupMany/Find",
+                               BM_LookupMany<0>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::set<int>/LookupMany/4",
+                               BM_LookupMany<4>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::set<int>/LookupMany/16",
+                               BM_LookupMany<16>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::set<int>/LookupMany/32",
+                               BM_LookupMany<32>)
+      ->Apply(Sizes);
+  for (int writers : {1, 4}) {
+    benchmark::RegisterBenchmark("LockedSet<int>/ConcurrentInsert",
+                                 BM_ConcurrentInsert<LockedSet>)
+        ->Args({1 << 18, writers})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark(
+        "s21::sharded_set<int, 16>/ConcurrentInsert",
+        BM_ConcurrentInsert<s21::sharded_set<int, 16>>)
+        ->Args({1 << 18, writers})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+    benchmark::RegisterBenchmark("s21::sharded_set<int, 16>/BulkInsert",
+                                 BM_ShardedBulkInsert)
+        ->Args({1 << 18, writers})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+  }
+  benchmark::RegisterBenchmark("s21::set<int>/Scratch",
+                               BM_ScratchSet<s21::set<int>, false>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::set<int>/Scratch/Arena",
+                               BM_ScratchSet<s21::set<int>, true>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("std::set<int>/Scratch",
+                               BM_ScratchSet<std::set<int>, false>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("std::pmr::set<int>/Scratch/Arena",
+                               BM_ScratchSet<std::pmr::set<int>, true>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::set<int>/ClearLatency",
+                               BM_ClearLatency<false>)
+      ->Apply(Sizes)
+      ->Iterations(10)
+      ->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("s21::set<int>/ClearLatency/Reclaimed",
+                               BM_ClearLatency<true>)
+      ->Apply(Sizes)
+      ->Iterations(10)
+      ->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("s21::set<int>/ContainsMostlyMiss",
+                               BM_ContainsMostlyMiss<s21::set<int>>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::filtered_set<int>/ContainsMostlyMiss",
+                               BM_ContainsMostlyMiss<s21::filtered_set<int>>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark(
+      "s21::filtered_set<int>/ContainsMostlyMiss/Frozen",
+      BM_ContainsMostlyMiss<s21::filtered_set<int>, true>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("std::set<int>/ContainsMostlyMiss",
+                               BM_ContainsMostlyMiss<std::set<int>>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::set<int>/FindZipf",
+                               BM_FindZipf<s21::set<int>>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("s21::cached_set<int>/FindZipf",
+                               BM_FindZipf<s21::cached_set<int>>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("std::set<int>/FindZipf",
+                               BM_FindZipf<std::set<int>>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMillisecond);
+  benchmark::RegisterBenchmark("s21::static_set<int, 64>/Table",
+                               BM_StaticTable<s21::static_set<int, 64>, 64>);
+  benchmark::RegisterBenchmark("s21::set<int>/Table/64",
+                               BM_StaticTable<s21::set<int>, 64>);
+  benchmark::RegisterBenchmark("std::set<int>/Table/64",
+                               BM_StaticTable<std::set<int>, 64>);
+  benchmark::RegisterBenchmark(
+      "s21::static_set<int, 1024>/Table",
+      BM_StaticTable<s21::static_set<int, 1024>, 1024>);
+  benchmark::RegisterBenchmark("s21::set<int>/Table/1024",
+                               BM_StaticTable<s21::set<int>, 1024>);
+  benchmark::RegisterBenchmark("std::set<int>/Table/1024",
+                               BM_StaticTable<std::set<int>, 1024>);
+  benchmark::RegisterBenchmark("s21::intersection_view<int>/Skewed",
+                               BM_IntersectSkewed<true>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("std::set_intersection<int>/Skewed",
+                               BM_IntersectSkewed<false>)
+      ->Apply(Sizes)
+      ->Unit(benchmark::kMicrosecond);
+  benchmark::RegisterBenchmark("s21::queue<uint64_t>/Churn",
+                               BM_QueueChurn<s21::queue<uint64_t>>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("std::queue<uint64_t>/Churn",
+                               BM_QueueChurn<std::queue<uint64_t>>)
+      ->Apply(Sizes);
+  benchmark::RegisterBenchmark("s21::spsc_queue<uint64_t>/Throughput",
+                               BM_SpscThroughput)
+      ->Arg(64)
+      ->Arg(1024)
+      ->Arg(65536)
+      ->UseRealTime()
+      ->Unit(benchmark::kMillisecond);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
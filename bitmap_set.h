@@ -0,0 +1,163 @@
+#ifndef BITMAP_SET_H
+#define BITMAP_SET_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "vector.h"
+
+namespace s21 {
+// Ordered set of 32-bit keys in the roaring layout: keys are grouped into
+// chunks by their upper 16 bits, a chunk keeps its lower halves in a sorted
+// array while it holds at most 4096 of them and in a 65536-bit bitmap after
+// that. Dense chunks cost one bit per possible key, sparse ones two bytes per
+// key, and set algebra between bitmaps runs as plain word loops.
+class bitmap_set {
+ public:
+  using key_type = uint32_t;
+  using value_type = uint32_t;
+  using size_type = size_t;
+
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = uint32_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const uint32_t *;
+    using reference = const uint32_t &;
+
+    Iterator() = default;
+    Iterator(const bitmap_set *owner, size_t chunk, uint32_t pos)
+        : owner_(owner), chunk_(chunk), pos_(pos) {
+      Load();
+    }
+
+    reference operator*() const { return value_; }
+    pointer operator->() const { return &value_; }
+
+    Iterator &operator++();
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    Iterator &operator--();
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return chunk_ == other.chunk_ && pos_ == other.pos_;
+    }
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+   private:
+    friend class bitmap_set;
+
+    void Load();
+
+    const bitmap_set *owner_ = nullptr;
+    size_t chunk_ = 0;
+    // index in an array chunk, the low half of the key in a bitmap chunk
+    uint32_t pos_ = 0;
+    uint32_t value_ = 0;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  bitmap_set() = default;
+  bitmap_set(std::initializer_list<value_type> const &items);
+  bitmap_set(const bitmap_set &s) = default;
+  bitmap_set(bitmap_set &&s) = default;
+  ~bitmap_set() = default;
+  bitmap_set &operator=(const bitmap_set &s) = default;
+  bitmap_set &operator=(bitmap_set &&s) = default;
+
+  iterator begin() const { return iterator(this, 0, FirstPos(0)); }
+  iterator end() const { return iterator(this, chunks_.size(), 0); }
+
+  bool empty() const { return chunks_.empty(); }
+  size_type size() const;
+  size_type max_size() const {
+    return size_type(std::numeric_limits<uint32_t>::max()) + 1;
+  }
+  // bytes held by the chunk directory and the containers
+  size_type memory_usage() const;
+
+  void clear() { chunks_.clear(); }
+  std::pair<iterator, bool> insert(const value_type &value);
+  template <typename... Args>
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
+  void erase(iterator pos) { erase(*pos); }
+  size_type erase(const key_type &key);
+  void swap(bitmap_set &other) { chunks_.swap(other.chunks_); }
+  void merge(bitmap_set &other);
+
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+  bitmap_set &operator|=(const bitmap_set &other);
+  bitmap_set &operator&=(const bitmap_set &other);
+  bitmap_set &operator-=(const bitmap_set &other);
+
+ private:
+  static constexpr uint32_t kArrayMax = 4096;
+  static constexpr uint32_t kWords = 65536 / 64;
+
+  struct Chunk {
+    uint16_t key_ = 0;
+    uint32_t card_ = 0;
+    // sorted low halves while the chunk is sparse
+    std::vector<uint16_t> array_;
+    // kWords words once the chunk is dense
+    std::vector<uint64_t> bitmap_;
+
+    bool IsBitmap() const { return !bitmap_.empty(); }
+    bool Contains(uint16_t low) const;
+  };
+
+  static uint16_t High(uint32_t key) { return key >> 16; }
+  static uint16_t Low(uint32_t key) { return key & 0xFFFF; }
+
+  // first set bit at or after from, kNone when there is none
+  static constexpr uint32_t kNone = 0x10000;
+  static uint32_t NextBit(const uint64_t *words, uint32_t from);
+  static uint32_t PrevBit(const uint64_t *words, uint32_t from);
+
+  static void ToBitmap(Chunk &chunk);
+  static void ToArray(Chunk &chunk);
+  static void Normalize(Chunk &chunk);
+  static Chunk Unite(const Chunk &a, const Chunk &b);
+  static Chunk Intersect(const Chunk &a, const Chunk &b);
+  static Chunk Subtract(const Chunk &a, const Chunk &b);
+
+  // index of the first chunk with key not less than high
+  size_t ChunkLowerBound(uint16_t high) const;
+  uint32_t FirstPos(size_t chunk) const;
+  uint32_t LastPos(size_t chunk) const;
+  // position of the first element not less than low in a chunk, or kNone
+  uint32_t PosLowerBound(size_t chunk, uint16_t low) const;
+
+  std::vector<Chunk> chunks_;
+};
+
+bitmap_set operator|(bitmap_set lhs, const bitmap_set &rhs);
+bitmap_set operator&(bitmap_set lhs, const bitmap_set &rhs);
+bitmap_set operator-(bitmap_set lhs, const bitmap_set &rhs);
+}  // namespace s21
+
+#include "bitmap_set.tpp"
+
+#endif
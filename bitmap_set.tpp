@@ -0,0 +1,466 @@
+#include <algorithm>
+
+#include "bitmap_set.h"
+
+inline s21::bitmap_set::bitmap_set(
+    std::initializer_list<value_type> const &items) {
+  for (const auto &elem : items) {
+    insert(elem);
+  }
+}
+
+inline void s21::bitmap_set::Iterator::Load() {
+  value_ = 0;
+  if (owner_ && chunk_ < owner_->chunks_.size()) {
+    const Chunk &c = owner_->chunks_[chunk_];
+    value_ = uint32_t(c.key_) << 16 | (c.IsBitmap() ? pos_ : c.array_[pos_]);
+  }
+}
+
+inline s21::bitmap_set::Iterator &s21::bitmap_set::Iterator::operator++() {
+  if (chunk_ < owner_->chunks_.size()) {
+    const Chunk &c = owner_->chunks_[chunk_];
+    uint32_t next = kNone;
+    if (c.IsBitmap()) {
+      next = pos_ == 0xFFFF ? kNone : NextBit(c.bitmap_.data(), pos_ + 1);
+    } else if (pos_ + 1 < c.card_) {
+      next = pos_ + 1;
+    }
+
+    if (next == kNone) {
+      ++chunk_;
+      pos_ = owner_->FirstPos(chunk_);
+    } else {
+      pos_ = next;
+    }
+    Load();
+  }
+
+  return *this;
+}
+
+inline s21::bitmap_set::Iterator &s21::bitmap_set::Iterator::operator--() {
+  uint32_t prev = kNone;
+  if (chunk_ < owner_->chunks_.size() && pos_ > 0) {
+    const Chunk &c = owner_->chunks_[chunk_];
+    prev = c.IsBitmap() ? PrevBit(c.bitmap_.data(), pos_ - 1) : pos_ - 1;
+  }
+
+  if (prev != kNone) {
+    pos_ = prev;
+  } else if (chunk_ > 0) {
+    --chunk_;
+    pos_ = owner_->LastPos(chunk_);
+  }
+  Load();
+
+  return *this;
+}
+
+inline bool s21::bitmap_set::Chunk::Contains(uint16_t low) const {
+  return IsBitmap() ? (bitmap_[low >> 6] >> (low & 63)) & 1
+                    : std::binary_search(array_.begin(), array_.end(), low);
+}
+
+inline s21::bitmap_set::size_type s21::bitmap_set::size() const {
+  size_type res = 0;
+  for (const Chunk &c : chunks_) {
+    res += c.card_;
+  }
+  return res;
+}
+
+inline s21::bitmap_set::size_type s21::bitmap_set::memory_usage() const {
+  size_type res = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const Chunk &c : chunks_) {
+    res += c.array_.capacity() * sizeof(uint16_t) +
+           c.bitmap_.capacity() * sizeof(uint64_t);
+  }
+  return res;
+}
+
+inline std::pair<s21::bitmap_set::iterator, bool> s21::bitmap_set::insert(
+    const value_type &value) {
+  uint16_t low = Low(value);
+  size_t ci = ChunkLowerBound(High(value));
+  if (ci == chunks_.size() || chunks_[ci].key_ != High(value)) {
+    Chunk chunk;
+    chunk.key_ = High(value);
+    chunks_.insert(chunks_.begin() + ci, std::move(chunk));
+  }
+
+  Chunk &c = chunks_[ci];
+  bool inserted = false;
+  if (c.IsBitmap()) {
+    uint64_t bit = uint64_t(1) << (low & 63);
+    inserted = !(c.bitmap_[low >> 6] & bit);
+    c.bitmap_[low >> 6] |= bit;
+  } else {
+    auto it = std::lower_bound(c.array_.begin(), c.array_.end(), low);
+    inserted = it == c.array_.end() || *it != low;
+    if (inserted) {
+      c.array_.insert(it, low);
+    }
+  }
+
+  if (inserted && ++c.card_ > kArrayMax && !c.IsBitmap()) {
+    ToBitmap(c);
+  }
+
+  return std::make_pair(iterator(this, ci, PosLowerBound(ci, low)), inserted);
+}
+
+template <typename... Args>
+s21::vector<std::pair<s21::bitmap_set::iterator, bool>, sizeof...(Args)>
+s21::bitmap_set::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
+
+  for (auto value : std::initializer_list<value_type>{args...}) {
+    results.push_back(insert(value));
+  }
+
+  return results;
+}
+
+inline s21::bitmap_set::size_type s21::bitmap_set::erase(const key_type &key) {
+  uint16_t low = Low(key);
+  size_t ci = ChunkLowerBound(High(key));
+  size_type res = 0;
+
+  if (ci < chunks_.size() && chunks_[ci].key_ == High(key) &&
+      chunks_[ci].Contains(low)) {
+    Chunk &c = chunks_[ci];
+    if (c.IsBitmap()) {
+      c.bitmap_[low >> 6] &= ~(uint64_t(1) << (low & 63));
+    } else {
+      c.array_.erase(std::lower_bound(c.array_.begin(), c.array_.end(), low));
+    }
+    res = 1;
+
+    if (--c.card_ == 0) {
+      chunks_.erase(chunks_.begin() + ci);
+    } else {
+      Normalize(c);
+    }
+  }
+
+  return res;
+}
+
+inline void s21::bitmap_set::merge(bitmap_set &other) {
+  if (this != &other) {
+    bitmap_set common = *this & other;
+    *this |= other;
+    other = std::move(common);
+  }
+}
+
+inline s21::bitmap_set::iterator s21::bitmap_set::find(
+    const key_type &key) const {
+  iterator res = lower_bound(key);
+  return res != end() && *res == key ? res : end();
+}
+
+inline bool s21::bitmap_set::contains(const key_type &key) const {
+  size_t ci = ChunkLowerBound(High(key));
+  return ci < chunks_.size() && chunks_[ci].key_ == High(key) &&
+         chunks_[ci].Contains(Low(key));
+}
+
+inline s21::bitmap_set::iterator s21::bitmap_set::lower_bound(
+    const key_type &key) const {
+  size_t ci = ChunkLowerBound(High(key));
+  uint32_t pos = kNone;
+  if (ci < chunks_.size() && chunks_[ci].key_ == High(key)) {
+    pos = PosLowerBound(ci, Low(key));
+    if (pos == kNone) {
+      ++ci;
+    }
+  }
+
+  return iterator(this, ci, pos == kNone ? FirstPos(ci) : pos);
+}
+
+inline s21::bitmap_set::iterator s21::bitmap_set::upper_bound(
+    const key_type &key) const {
+  return key == std::numeric_limits<uint32_t>::max() ? end()
+                                                     : lower_bound(key + 1);
+}
+
+inline s21::bitmap_set &s21::bitmap_set::operator|=(const bitmap_set &other) {
+  if (this != &other) {
+    std::vector<Chunk> res;
+    res.reserve(chunks_.size() + other.chunks_.size());
+    size_t i = 0, j = 0;
+    while (i < chunks_.size() || j < other.chunks_.size()) {
+      if (j == other.chunks_.size() ||
+          (i < chunks_.size() && chunks_[i].key_ < other.chunks_[j].key_)) {
+        res.push_back(std::move(chunks_[i++]));
+      } else if (i == chunks_.size() ||
+                 other.chunks_[j].key_ < chunks_[i].key_) {
+        res.push_back(other.chunks_[j++]);
+      } else {
+        res.push_back(Unite(chunks_[i++], other.chunks_[j++]));
+      }
+    }
+    chunks_.swap(res);
+  }
+
+  return *this;
+}
+
+inline s21::bitmap_set &s21::bitmap_set::operator&=(const bitmap_set &other) {
+  if (this != &other) {
+    std::vector<Chunk> res;
+    size_t i = 0, j = 0;
+    while (i < chunks_.size() && j < other.chunks_.size()) {
+      if (chunks_[i].key_ < other.chunks_[j].key_) {
+        ++i;
+      } else if (other.chunks_[j].key_ < chunks_[i].key_) {
+        ++j;
+      } else {
+        Chunk c = Intersect(chunks_[i++], other.chunks_[j++]);
+        if (c.card_) {
+          res.push_back(std::move(c));
+        }
+      }
+    }
+    chunks_.swap(res);
+  }
+
+  return *this;
+}
+
+inline s21::bitmap_set &s21::bitmap_set::operator-=(const bitmap_set &other) {
+  if (this == &other) {
+    clear();
+  } else {
+    std::vector<Chunk> res;
+    res.reserve(chunks_.size());
+    size_t j = 0;
+    for (Chunk &c : chunks_) {
+      while (j < other.chunks_.size() && other.chunks_[j].key_ < c.key_) {
+        ++j;
+      }
+      if (j < other.chunks_.size() && other.chunks_[j].key_ == c.key_) {
+        Chunk diff = Subtract(c, other.chunks_[j]);
+        if (diff.card_) {
+          res.push_back(std::move(diff));
+        }
+      } else {
+        res.push_back(std::move(c));
+      }
+    }
+    chunks_.swap(res);
+  }
+
+  return *this;
+}
+
+inline uint32_t s21::bitmap_set::NextBit(const uint64_t *words,
+                                         uint32_t from) {
+  uint32_t w = from >> 6;
+  uint64_t m = words[w] & (~uint64_t(0) << (from & 63));
+  while (!m && ++w < kWords) {
+    m = words[w];
+  }
+  return m ? w * 64 + std::countr_zero(m) : kNone;
+}
+
+inline uint32_t s21::bitmap_set::PrevBit(const uint64_t *words,
+                                         uint32_t from) {
+  uint32_t w = from >> 6;
+  uint32_t b = from & 63;
+  uint64_t m = words[w] & (b == 63 ? ~uint64_t(0) : (uint64_t(2) << b) - 1);
+  while (!m && w > 0) {
+    m = words[--w];
+  }
+  return m ? w * 64 + 63 - std::countl_zero(m) : kNone;
+}
+
+inline void s21::bitmap_set::ToBitmap(Chunk &chunk) {
+  chunk.bitmap_.assign(kWords, 0);
+  for (uint16_t low : chunk.array_) {
+    chunk.bitmap_[low >> 6] |= uint64_t(1) << (low & 63);
+  }
+  std::vector<uint16_t>().swap(chunk.array_);
+}
+
+inline void s21::bitmap_set::ToArray(Chunk &chunk) {
+  std::vector<uint16_t> array;
+  array.reserve(chunk.card_);
+  for (uint32_t w = 0; w < kWords; ++w) {
+    for (uint64_t m = chunk.bitmap_[w]; m; m &= m - 1) {
+      array.push_back(static_cast<uint16_t>(w * 64 + std::countr_zero(m)));
+    }
+  }
+  chunk.array_.swap(array);
+  std::vector<uint64_t>().swap(chunk.bitmap_);
+}
+
+inline void s21::bitmap_set::Normalize(Chunk &chunk) {
+  if (chunk.IsBitmap() && chunk.card_ <= kArrayMax) {
+    ToArray(chunk);
+  } else if (!chunk.IsBitmap() && chunk.card_ > kArrayMax) {
+    ToBitmap(chunk);
+  }
+}
+
+namespace s21 {
+// the word loops below have no dependencies between iterations, so the
+// compiler turns them into vector or/and/andnot and popcount instructions
+inline uint32_t BitmapCardinality(const uint64_t *words, uint32_t n) {
+  uint32_t card = 0;
+  for (uint32_t i = 0; i < n; ++i) {
+    card += std::popcount(words[i]);
+  }
+  return card;
+}
+}  // namespace s21
+
+inline s21::bitmap_set::Chunk s21::bitmap_set::Unite(const Chunk &a,
+                                                     const Chunk &b) {
+  Chunk res;
+  res.key_ = a.key_;
+
+  if (!a.IsBitmap() && !b.IsBitmap()) {
+    res.array_.reserve(a.card_ + b.card_);
+    std::set_union(a.array_.begin(), a.array_.end(), b.array_.begin(),
+                   b.array_.end(), std::back_inserter(res.array_));
+    res.card_ = res.array_.size();
+  } else {
+    const Chunk &dense = a.IsBitmap() ? a : b;
+    const Chunk &other = a.IsBitmap() ? b : a;
+    res.bitmap_ = dense.bitmap_;
+    uint64_t *out = res.bitmap_.data();
+    if (other.IsBitmap()) {
+      const uint64_t *in = other.bitmap_.data();
+      for (uint32_t i = 0; i < kWords; ++i) {
+        out[i] |= in[i];
+      }
+    } else {
+      for (uint16_t low : other.array_) {
+        out[low >> 6] |= uint64_t(1) << (low & 63);
+      }
+    }
+    res.card_ = BitmapCardinality(out, kWords);
+  }
+  Normalize(res);
+
+  return res;
+}
+
+inline s21::bitmap_set::Chunk s21::bitmap_set::Intersect(const Chunk &a,
+                                                         const Chunk &b) {
+  Chunk res;
+  res.key_ = a.key_;
+
+  if (a.IsBitmap() && b.IsBitmap()) {
+    res.bitmap_.resize(kWords);
+    uint64_t *out = res.bitmap_.data();
+    const uint64_t *x = a.bitmap_.data();
+    const uint64_t *y = b.bitmap_.data();
+    for (uint32_t i = 0; i < kWords; ++i) {
+      out[i] = x[i] & y[i];
+    }
+    res.card_ = BitmapCardinality(out, kWords);
+    Normalize(res);
+  } else if (!a.IsBitmap() && !b.IsBitmap()) {
+    std::set_intersection(a.array_.begin(), a.array_.end(), b.array_.begin(),
+                          b.array_.end(), std::back_inserter(res.array_));
+    res.card_ = res.array_.size();
+  } else {
+    const Chunk &sparse = a.IsBitmap() ? b : a;
+    const Chunk &dense = a.IsBitmap() ? a : b;
+    for (uint16_t low : sparse.array_) {
+      if (dense.Contains(low)) {
+        res.array_.push_back(low);
+      }
+    }
+    res.card_ = res.array_.size();
+  }
+
+  return res;
+}
+
+inline s21::bitmap_set::Chunk s21::bitmap_set::Subtract(const Chunk &a,
+                                                        const Chunk &b) {
+  Chunk res;
+  res.key_ = a.key_;
+
+  if (!a.IsBitmap()) {
+    for (uint16_t low : a.array_) {
+      if (!b.Contains(low)) {
+        res.array_.push_back(low);
+      }
+    }
+    res.card_ = res.array_.size();
+  } else {
+    res.bitmap_ = a.bitmap_;
+    uint64_t *out = res.bitmap_.data();
+    if (b.IsBitmap()) {
+      const uint64_t *in = b.bitmap_.data();
+      for (uint32_t i = 0; i < kWords; ++i) {
+        out[i] &= ~in[i];
+      }
+    } else {
+      for (uint16_t low : b.array_) {
+        out[low >> 6] &= ~(uint64_t(1) << (low & 63));
+      }
+    }
+    res.card_ = BitmapCardinality(out, kWords);
+    Normalize(res);
+  }
+
+  return res;
+}
+
+inline size_t s21::bitmap_set::ChunkLowerBound(uint16_t high) const {
+  return std::lower_bound(
+             chunks_.begin(), chunks_.end(), high,
+             [](const Chunk &c, uint16_t key) { return c.key_ < key; }) -
+         chunks_.begin();
+}
+
+inline uint32_t s21::bitmap_set::FirstPos(size_t chunk) const {
+  uint32_t res = 0;
+  if (chunk < chunks_.size() && chunks_[chunk].IsBitmap()) {
+    res = NextBit(chunks_[chunk].bitmap_.data(), 0);
+  }
+  return res;
+}
+
+inline uint32_t s21::bitmap_set::LastPos(size_t chunk) const {
+  const Chunk &c = chunks_[chunk];
+  return c.IsBitmap() ? PrevBit(c.bitmap_.data(), 0xFFFF) : c.card_ - 1;
+}
+
+inline uint32_t s21::bitmap_set::PosLowerBound(size_t chunk,
+                                               uint16_t low) const {
+  const Chunk &c = chunks_[chunk];
+  uint32_t res = kNone;
+  if (c.IsBitmap()) {
+    res = NextBit(c.bitmap_.data(), low);
+  } else {
+    auto it = std::lower_bound(c.array_.begin(), c.array_.end(), low);
+    if (it != c.array_.end()) {
+      res = it - c.array_.begin();
+    }
+  }
+  return res;
+}
+
+inline s21::bitmap_set s21::operator|(bitmap_set lhs, const bitmap_set &rhs) {
+  lhs |= rhs;
+  return lhs;
+}
+
+inline s21::bitmap_set s21::operator&(bitmap_set lhs, const bitmap_set &rhs) {
+  lhs &= rhs;
+  return lhs;
+}
+
+inline s21::bitmap_set s21::operator-(bitmap_set lhs, const bitmap_set &rhs) {
+  lhs -= rhs;
+  return lhs;
+}
@@ -0,0 +1,114 @@
+#ifndef CACHED_SET_H
+#define CACHED_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "set.h"
+
+namespace s21 {
+struct CacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+
+  double hit_rate() const {
+    return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0;
+  }
+};
+
+// s21::set with a direct-mapped cache of recently found nodes in front of
+// the tree. A lookup hashes the key to one slot and, when the node cached
+// there holds the key, answers with two comparisons instead of a descent;
+// on a miss it descends and caches the node it found. Under a skewed load
+// the hot keys stay in the cache and cost O(1).
+//
+// Nodes never move, so inserts keep the cache valid; erase, extract, merge
+// and clear drop the slots of the nodes they take away. Lookups write to
+// the cache, so unlike set even find and contains are not safe to call
+// from several threads at once.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Hash = std::hash<Key>>
+class cached_set {
+ public:
+  using set_type = set<Key, Compare>;
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename set_type::iterator;
+  using const_iterator = typename set_type::const_iterator;
+  using size_type = size_t;
+  using node_type = typename set_type::node_type;
+
+  // cache_slots is rounded up to a power of two
+  explicit cached_set(size_type cache_slots = 1024);
+  cached_set(std::initializer_list<value_type> const &items);
+  cached_set(const cached_set &other);
+  // the moved-from set is left empty with a fresh cache of its size
+  cached_set(cached_set &&other);
+  ~cached_set() = default;
+  cached_set &operator=(const cached_set &other);
+  cached_set &operator=(cached_set &&other);
+
+  iterator begin() { return set_.begin(); }
+  const_iterator begin() const { return set_.begin(); }
+  iterator end() { return set_.end(); }
+  const_iterator end() const { return set_.end(); }
+
+  bool empty() const { return set_.empty(); }
+  size_type size() const { return set_.size(); }
+  size_type max_size() const { return set_.max_size(); }
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return set_.insert(value);
+  }
+  template <typename... Args>
+  auto insert_many(Args &&...args) {
+    return set_.insert_many(std::forward<Args>(args)...);
+  }
+  void erase(iterator pos);
+  size_type erase(const key_type &key);
+  node_type extract(iterator pos);
+  void swap(cached_set &other);
+  void merge(cached_set &other);
+
+  iterator find(const key_type &key);
+  bool contains(const key_type &key) { return find(key) != end(); }
+  size_type count(const key_type &key) { return contains(key); }
+  iterator lower_bound(const key_type &key) { return set_.lower_bound(key); }
+  iterator upper_bound(const key_type &key) { return set_.upper_bound(key); }
+
+  // the plain tree, its const reads leave the cache alone
+  const set_type &base() const { return set_; }
+
+  size_type cache_slots() const { return cache_.size(); }
+  CacheStats cache_stats() const { return stats_; }
+  void reset_cache_stats() { stats_ = CacheStats(); }
+
+  bool validate() const;
+
+ private:
+  size_t Slot(const key_type &key) const;
+  bool Equal(const key_type &a, const key_type &b) const {
+    return !comp_(a, b) && !comp_(b, a);
+  }
+  // drops the cache entry of the node at pos, if there is one
+  void Forget(iterator pos);
+
+  set_type set_;
+  std::vector<iterator> cache_;
+  int shift_ = 0;
+  CacheStats stats_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Hash hash_;
+};
+}  // namespace s21
+
+#include "cached_set.tpp"
+
+#endif
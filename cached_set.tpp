@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#include "cached_set.h"
+
+template <typename Key, typename Compare, typename Hash>
+s21::cached_set<Key, Compare, Hash>::cached_set(size_type cache_slots)
+    : cache_(std::bit_ceil(std::max<size_type>(cache_slots, 2))),
+      shift_(64 - std::countr_zero(cache_.size())) {}
+
+template <typename Key, typename Compare, typename Hash>
+s21::cached_set<Key, Compare, Hash>::cached_set(
+    std::initializer_list<value_type> const &items)
+    : cached_set() {
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+// the copy starts with an empty cache, the entries belong to other's nodes
+template <typename Key, typename Compare, typename Hash>
+s21::cached_set<Key, Compare, Hash>::cached_set(const cached_set &other)
+    : set_(other.set_),
+      cache_(other.cache_.size()),
+      shift_(other.shift_),
+      comp_(other.comp_),
+      hash_(other.hash_) {}
+
+template <typename Key, typename Compare, typename Hash>
+s21::cached_set<Key, Compare, Hash> &
+s21::cached_set<Key, Compare, Hash>::operator=(const cached_set &other) {
+  if (this != &other) {
+    *this = cached_set(other);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Hash>
+s21::cached_set<Key, Compare, Hash>::cached_set(cached_set &&other)
+    : cached_set(other.cache_.size()) {
+  swap(other);
+}
+
+template <typename Key, typename Compare, typename Hash>
+s21::cached_set<Key, Compare, Hash> &
+s21::cached_set<Key, Compare, Hash>::operator=(cached_set &&other) {
+  if (this != &other) {
+    cached_set moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::cached_set<Key, Compare, Hash>::clear() {
+  set_.clear();
+  std::fill(cache_.begin(), cache_.end(), iterator());
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::cached_set<Key, Compare, Hash>::erase(iterator pos) {
+  Forget(pos);
+  set_.erase(pos);
+}
+
+template <typename Key, typename Compare, typename Hash>
+typename s21::cached_set<Key, Compare, Hash>::size_type
+s21::cached_set<Key, Compare, Hash>::erase(const key_type &key) {
+  iterator pos = find(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase(pos);
+  return 1;
+}
+
+template <typename Key, typename Compare, typename Hash>
+typename s21::cached_set<Key, Compare, Hash>::node_type
+s21::cached_set<Key, Compare, Hash>::extract(iterator pos) {
+  Forget(pos);
+  return set_.extract(pos);
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::cached_set<Key, Compare, Hash>::swap(cached_set &other) {
+  set_.swap(other.set_);
+  cache_.swap(other.cache_);
+  std::swap(shift_, other.shift_);
+  std::swap(stats_, other.stats_);
+  std::swap(comp_, other.comp_);
+  std::swap(hash_, other.hash_);
+}
+
+// nodes only move from other to here, so just other's cache goes stale
+template <typename Key, typename Compare, typename Hash>
+void s21::cached_set<Key, Compare, Hash>::merge(cached_set &other) {
+  if (this != &other) {
+    set_.merge(other.set_);
+    std::fill(other.cache_.begin(), other.cache_.end(), iterator());
+  }
+}
+
+template <typename Key, typename Compare, typename Hash>
+typename s21::cached_set<Key, Compare, Hash>::iterator
+s21::cached_set<Key, Compare, Hash>::find(const key_type &key) {
+  iterator &entry = cache_[Slot(key)];
+  if (entry.node_ && Equal(*entry, key)) {
+    ++stats_.hits;
+    // the entry may predate a move of the set, so it gets the current owner
+    iterator res = end();
+    res.node_ = entry.node_;
+    return res;
+  }
+  ++stats_.misses;
+  iterator res = set_.find(key);
+  if (res != end()) {
+    entry = res;
+  }
+  return res;
+}
+
+template <typename Key, typename Compare, typename Hash>
+bool s21::cached_set<Key, Compare, Hash>::validate() const {
+  for (const iterator &entry : cache_) {
+    if (entry.node_ && set_.find(*entry).node_ != entry.node_) {
+      return false;
+    }
+  }
+  return set_.validate();
+}
+
+// Fibonacci hashing: the top bits of the product pick the slot, so
+// identity hashes of small integers still spread over the cache
+template <typename Key, typename Compare, typename Hash>
+size_t s21::cached_set<Key, Compare, Hash>::Slot(const key_type &key) const {
+  return (static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull) >> shift_;
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::cached_set<Key, Compare, Hash>::Forget(iterator pos) {
+  iterator &entry = cache_[Slot(*pos)];
+  if (entry.node_ == pos.node_) {
+    entry = iterator();
+  }
+}
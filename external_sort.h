@@ -0,0 +1,125 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "multiset.h"
+#include "set.h"
+#include "sorted_file.h"
+
+namespace s21 {
+// Sorts a key stream that does not fit in memory. Keys are buffered up to
+// run_keys at a time, each full buffer is sorted and spilled to an unlinked
+// temp file in the sorted file format, and the output is a k-way merge of
+// the runs with the keys still in the buffer. Without Multi equal keys are
+// dropped, both inside a run and across runs.
+//
+// write and build consume the sorter: afterwards it is empty again.
+// I/O errors are reported with std::runtime_error.
+template <typename Key, typename Compare = std::less<Key>, bool Multi = false>
+class external_sorter {
+  static_assert(std::is_trivially_copyable_v<Key>,
+                "sorted files store keys as raw bytes");
+
+ public:
+  using key_type = Key;
+  using size_type = size_t;
+  using container_type =
+      std::conditional_t<Multi, multiset<Key, Compare>, set<Key, Compare>>;
+
+  explicit external_sorter(size_type run_keys = size_type(1) << 20,
+                           std::string temp_dir = "/tmp");
+  external_sorter(const external_sorter &) = delete;
+  external_sorter &operator=(const external_sorter &) = delete;
+  ~external_sorter() { Reset(); }
+
+  void push(const Key &key);
+  template <typename InputIt>
+  void push(InputIt first, InputIt last) {
+    for (; first != last; ++first) push(*first);
+  }
+
+  // keys pushed so far, duplicates included
+  uint64_t pushed() const { return pushed_; }
+  size_type runs() const { return runs_.size(); }
+
+  // merges into a sorted file that set::deserialize and mapped_set can read,
+  // returns the number of keys written
+  uint64_t write(const std::string &path);
+  uint64_t write(int fd);
+  // merges into memory, throws std::length_error when the result has more
+  // than max_keys keys
+  container_type build(size_type max_keys);
+
+ private:
+  void Spill();
+  void SortBuffer();
+  template <typename Fn>
+  void Merge(Fn fn);
+  void Reset();
+
+  size_type run_keys_;
+  std::string temp_dir_;
+  uint64_t pushed_ = 0;
+  std::vector<Key> buffer_;
+  std::vector<int> runs_;
+  Compare comp_;
+};
+
+// Forward cursor over a sorted file read with buffered pread calls, for
+// files too large to map or load. lower_bound binary searches the file one
+// key per probe until the range fits the buffer, then searches the buffer.
+template <typename Key, typename Compare = std::less<Key>>
+class sorted_file_cursor {
+  static_assert(std::is_trivially_copyable_v<Key>,
+                "sorted files store keys as raw bytes");
+
+ public:
+  explicit sorted_file_cursor(const std::string &path,
+                              size_t buffer_keys = 1 << 14);
+  sorted_file_cursor(const sorted_file_cursor &) = delete;
+  sorted_file_cursor &operator=(const sorted_file_cursor &) = delete;
+  ~sorted_file_cursor();
+
+  uint64_t size() const { return header_.count_; }
+  bool multi() const { return header_.flags_ & kSortedFileMulti; }
+
+  // the cursor is valid while it points before the end of the file
+  bool valid() const { return pos_ < header_.count_; }
+  explicit operator bool() const { return valid(); }
+  uint64_t position() const { return pos_; }
+  const Key &operator*() const { return buffer_[pos_ - buffer_pos_]; }
+  const Key *operator->() const { return &**this; }
+
+  sorted_file_cursor &operator++();
+  void seek(uint64_t position);
+  void rewind() { seek(0); }
+  // moves to the first key not less than key, returns valid()
+  bool lower_bound(const Key &key);
+
+ private:
+  // loads the buffer with the keys from position on
+  void Fill(uint64_t position);
+  Key ReadKey(uint64_t position) const;
+  void ReadAt(void *data, size_t len, uint64_t offset) const;
+
+  int fd_ = -1;
+  SortedFileHeader header_;
+  size_t buffer_keys_;
+  std::vector<Key> buffer_;
+  // index of buffer_[0] in the file
+  uint64_t buffer_pos_ = 0;
+  uint64_t pos_ = 0;
+  Compare comp_;
+};
+}  // namespace s21
+
+#include "external_sort.tpp"
+
+#endif
@@ -0,0 +1,314 @@
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+#include "external_sort.h"
+
+template <typename Key, typename Compare, bool Multi>
+s21::external_sorter<Key, Compare, Multi>::external_sorter(
+    size_type run_keys, std::string temp_dir)
+    : run_keys_(std::max<size_type>(run_keys, 1)),
+      temp_dir_(std::move(temp_dir)) {}
+
+template <typename Key, typename Compare, bool Multi>
+void s21::external_sorter<Key, Compare, Multi>::push(const Key &key) {
+  buffer_.push_back(key);
+  ++pushed_;
+  if (buffer_.size() >= run_keys_) {
+    Spill();
+  }
+}
+
+template <typename Key, typename Compare, bool Multi>
+uint64_t s21::external_sorter<Key, Compare, Multi>::write(
+    const std::string &path) {
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    Reset();
+    throw std::runtime_error("external_sorter: can not create " + path);
+  }
+  uint64_t res = 0;
+  try {
+    res = write(fd);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+  return res;
+}
+
+template <typename Key, typename Compare, bool Multi>
+uint64_t s21::external_sorter<Key, Compare, Multi>::write(int fd) {
+  SortedFileWriter<Key> writer(fd, Multi);
+  Merge([&writer](const Key &key) { writer.Add(key); });
+  writer.Finish();
+  return writer.Count();
+}
+
+template <typename Key, typename Compare, bool Multi>
+typename s21::external_sorter<Key, Compare, Multi>::container_type
+s21::external_sorter<Key, Compare, Multi>::build(size_type max_keys) {
+  std::vector<Key> keys;
+  Merge([&keys, max_keys](const Key &key) {
+    if (keys.size() == max_keys) {
+      throw std::length_error("external_sorter: result exceeds max_keys");
+    }
+    keys.push_back(key);
+  });
+  return container_type::from_sorted(keys.data(), keys.size());
+}
+
+template <typename Key, typename Compare, bool Multi>
+void s21::external_sorter<Key, Compare, Multi>::Spill() {
+  SortBuffer();
+  std::string path = temp_dir_ + "/s21_run_XXXXXX";
+  int fd = ::mkstemp(path.data());
+  if (fd < 0) {
+    throw std::runtime_error("external_sorter: can not create a run in " +
+                             temp_dir_);
+  }
+  // the run lives as long as its descriptor, even if the process dies
+  ::unlink(path.c_str());
+  runs_.push_back(fd);
+
+  SortedFileWriter<Key> writer(fd, Multi);
+  for (const Key &key : buffer_) {
+    writer.Add(key);
+  }
+  writer.Finish();
+  buffer_.clear();
+}
+
+template <typename Key, typename Compare, bool Multi>
+void s21::external_sorter<Key, Compare, Multi>::SortBuffer() {
+  std::sort(buffer_.begin(), buffer_.end(), comp_);
+  if constexpr (!Multi) {
+    auto last = std::unique(
+        buffer_.begin(), buffer_.end(),
+        [this](const Key &a, const Key &b) { return !comp_(a, b); });
+    buffer_.erase(last, buffer_.end());
+  }
+}
+
+// Every run is read through its own buffer, together they hold about as
+// many keys as one run, and a heap of run indices picks the smallest head.
+template <typename Key, typename Compare, bool Multi>
+template <typename Fn>
+void s21::external_sorter<Key, Compare, Multi>::Merge(Fn fn) {
+  struct Source {
+    std::unique_ptr<SortedFileReader<Key>> reader;
+    std::vector<Key> keys;
+    size_t pos = 0;
+  };
+
+  try {
+    SortBuffer();
+    const size_t chunk = std::max<size_t>(run_keys_ / (runs_.size() + 1),
+                                          kSortedFilePage / sizeof(Key) + 1);
+    std::vector<Source> sources(runs_.size() + 1);
+    for (size_t i = 0; i < runs_.size(); ++i) {
+      if (::lseek(runs_[i], 0, SEEK_SET) != 0) {
+        throw std::runtime_error("external_sorter: can not rewind a run");
+      }
+      sources[i].reader = std::make_unique<SortedFileReader<Key>>(runs_[i]);
+    }
+    sources.back().keys.swap(buffer_);
+
+    auto refill = [chunk](Source &src) {
+      if (src.pos < src.keys.size()) {
+        return true;
+      }
+      if (!src.reader) {
+        return false;
+      }
+      src.keys.resize(chunk);
+      src.keys.resize(src.reader->Read(src.keys.data(), chunk));
+      src.pos = 0;
+      if (src.keys.empty()) {
+        src.reader->Verify();
+        src.reader.reset();
+        return false;
+      }
+      return true;
+    };
+    // ties go to the older run, so equal keys keep the order of the stream
+    auto later = [this, &sources](size_t a, size_t b) {
+      const Key &ka = sources[a].keys[sources[a].pos];
+      const Key &kb = sources[b].keys[sources[b].pos];
+      if (comp_(kb, ka)) return true;
+      if (comp_(ka, kb)) return false;
+      return a > b;
+    };
+
+    std::vector<size_t> heap;
+    for (size_t i = 0; i < sources.size(); ++i) {
+      if (refill(sources[i])) {
+        heap.push_back(i);
+      }
+    }
+    std::make_heap(heap.begin(), heap.end(), later);
+
+    Key last{};
+    bool have_last = false;
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), later);
+      Source &src = sources[heap.back()];
+      const Key &key = src.keys[src.pos];
+      if (Multi || !have_last || comp_(last, key)) {
+        fn(key);
+        last = key;
+        have_last = true;
+      }
+      ++src.pos;
+      if (refill(src)) {
+        std::push_heap(heap.begin(), heap.end(), later);
+      } else {
+        heap.pop_back();
+      }
+    }
+  } catch (...) {
+    Reset();
+    throw;
+  }
+  Reset();
+}
+
+template <typename Key, typename Compare, bool Multi>
+void s21::external_sorter<Key, Compare, Multi>::Reset() {
+  for (int fd : runs_) {
+    ::close(fd);
+  }
+  runs_.clear();
+  buffer_.clear();
+  pushed_ = 0;
+}
+
+template <typename Key, typename Compare>
+s21::sorted_file_cursor<Key, Compare>::sorted_file_cursor(
+    const std::string &path, size_t buffer_keys)
+    : buffer_keys_(std::max<size_t>(buffer_keys, 1)) {
+  fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0) {
+    throw std::runtime_error("sorted_file_cursor: can not open " + path);
+  }
+  try {
+    ReadAt(&header_, sizeof(header_), 0);
+    header_.Check(sizeof(Key), alignof(Key));
+    struct stat st;
+    if (::fstat(fd_, &st) != 0 ||
+        static_cast<uint64_t>(st.st_size) <
+            header_.data_offset_ + header_.count_ * sizeof(Key)) {
+      throw std::runtime_error("sorted file: truncated");
+    }
+    if (header_.count_) {
+      Fill(0);
+    }
+  } catch (...) {
+    ::close(fd_);
+    throw;
+  }
+}
+
+template <typename Key, typename Compare>
+s21::sorted_file_cursor<Key, Compare>::~sorted_file_cursor() {
+  ::close(fd_);
+}
+
+template <typename Key, typename Compare>
+s21::sorted_file_cursor<Key, Compare> &
+s21::sorted_file_cursor<Key, Compare>::operator++() {
+  ++pos_;
+  if (valid() && pos_ == buffer_pos_ + buffer_.size()) {
+    Fill(pos_);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare>
+void s21::sorted_file_cursor<Key, Compare>::seek(uint64_t position) {
+  pos_ = std::min<uint64_t>(position, header_.count_);
+  if (valid() &&
+      (pos_ < buffer_pos_ || pos_ >= buffer_pos_ + buffer_.size())) {
+    Fill(pos_);
+  }
+}
+
+template <typename Key, typename Compare>
+bool s21::sorted_file_cursor<Key, Compare>::lower_bound(const Key &key) {
+  // the answer is in [lo, hi], the buffer narrows it for free
+  uint64_t lo = 0;
+  uint64_t hi = header_.count_;
+  if (!buffer_.empty()) {
+    if (comp_(buffer_.back(), key)) {
+      lo = buffer_pos_ + buffer_.size();
+    } else if (comp_(buffer_.front(), key)) {
+      lo = buffer_pos_;
+      hi = buffer_pos_ + buffer_.size() - 1;
+    } else {
+      hi = buffer_pos_;
+    }
+  }
+  while (hi - lo > buffer_keys_) {
+    uint64_t mid = lo + (hi - lo) / 2;
+    if (comp_(ReadKey(mid), key)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if (lo == header_.count_) {
+    pos_ = lo;
+    return false;
+  }
+  if (lo < buffer_pos_ || hi > buffer_pos_ + buffer_.size()) {
+    Fill(lo);
+  }
+  auto first = buffer_.begin() + (lo - buffer_pos_);
+  auto last = buffer_.begin() + (hi - buffer_pos_);
+  pos_ = buffer_pos_ + (std::lower_bound(first, last, key, comp_) -
+                        buffer_.begin());
+  if (valid() && pos_ == buffer_pos_ + buffer_.size()) {
+    Fill(pos_);
+  }
+  return valid();
+}
+
+template <typename Key, typename Compare>
+void s21::sorted_file_cursor<Key, Compare>::Fill(uint64_t position) {
+  size_t n = std::min<uint64_t>(buffer_keys_, header_.count_ - position);
+  buffer_.resize(n);
+  ReadAt(buffer_.data(), n * sizeof(Key),
+         header_.data_offset_ + position * sizeof(Key));
+  buffer_pos_ = position;
+}
+
+template <typename Key, typename Compare>
+Key s21::sorted_file_cursor<Key, Compare>::ReadKey(uint64_t position) const {
+  Key res{};
+  ReadAt(&res, sizeof(Key), header_.data_offset_ + position * sizeof(Key));
+  return res;
+}
+
+template <typename Key, typename Compare>
+void s21::sorted_file_cursor<Key, Compare>::ReadAt(void *data, size_t len,
+                                                   uint64_t offset) const {
+  char *p = static_cast<char *>(data);
+  while (len) {
+    ssize_t done = ::pread(fd_, p, len, offset);
+    if (done == 0 || (done < 0 && errno != EINTR)) {
+      throw std::runtime_error("sorted file: unexpected end of data");
+    }
+    if (done > 0) {
+      p += done;
+      offset += done;
+      len -= done;
+    }
+  }
+}
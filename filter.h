@@ -0,0 +1,181 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace s21 {
+// Approximate membership filters over 64-bit key hashes. Both answer "maybe"
+// for every hash they were given and "no" for most others, so a container
+// can skip its lookup whenever a filter says no. The hashes have to be well
+// mixed already, FilterHash turns a plain std::hash value into one.
+
+// murmur3 finalizer: std::hash of an integer is the integer itself, and both
+// filters below take their positions from different bits of the hash
+inline uint64_t FilterHash(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+// Split-block Bloom filter: a key sets one bit in each of the eight words of
+// a single 64-byte block, so a query reads one cache line. Bits cannot be
+// cleared, the owner rebuilds the filter to forget erased keys.
+class BloomFilter {
+ public:
+  BloomFilter() = default;
+  // room for capacity keys at bits_per_key bits each, rounded up to blocks
+  BloomFilter(size_t capacity, size_t bits_per_key)
+      : blocks_((capacity * bits_per_key + kBlockBits - 1) / kBlockBits),
+        capacity_(capacity) {}
+
+  void Insert(uint64_t hash) {
+    Block &block = blocks_[BlockOf(hash)];
+    for (int i = 0; i < kWords; ++i) {
+      block.words[i] |= Mask(hash, i);
+    }
+  }
+
+  bool MayContain(uint64_t hash) const {
+    if (blocks_.empty()) {
+      return false;
+    }
+    const Block &block = blocks_[BlockOf(hash)];
+    for (int i = 0; i < kWords; ++i) {
+      if (!(block.words[i] & Mask(hash, i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t Capacity() const { return capacity_; }
+  size_t MemoryBytes() const { return blocks_.size() * sizeof(Block); }
+
+ private:
+  static constexpr int kWords = 8;
+  static constexpr size_t kBlockBits = kWords * 64;
+  // odd multipliers of the Parquet split-block filter, one per word
+  static constexpr uint32_t kSalt[kWords] = {
+      0x47B6137Bu, 0x44974D91u, 0x8824AD5Bu, 0xA2B7289Du,
+      0x705495C7u, 0x2DF1424Bu, 0x9EFC4947u, 0x5C6BFB31u};
+
+  struct alignas(64) Block {
+    uint64_t words[kWords] = {};
+  };
+
+  // the high half of the hash picks the block, the low half the bits
+  size_t BlockOf(uint64_t hash) const {
+    return ((hash >> 32) * blocks_.size()) >> 32;
+  }
+  static uint64_t Mask(uint64_t hash, int i) {
+    return uint64_t{1} << ((static_cast<uint32_t>(hash) * kSalt[i]) >> 26);
+  }
+
+  std::vector<Block> blocks_;
+  size_t capacity_ = 0;
+};
+
+// Xor filter with 8-bit fingerprints: a hash maps to three slots, one per
+// third of the array, and is in the filter when the xor of their bytes
+// equals its fingerprint. It takes about 9.9 bits per key for a false
+// positive rate of 1/256, but is built once from the full key set and
+// cannot take inserts afterwards.
+class XorFilter {
+ public:
+  XorFilter() = default;
+  explicit XorFilter(std::vector<uint64_t> hashes) { Build(std::move(hashes)); }
+
+  bool MayContain(uint64_t hash) const {
+    if (fingerprints_.empty()) {
+      return false;
+    }
+    uint64_t x = FilterHash(hash + seed_);
+    uint8_t f = static_cast<uint8_t>(x ^ (x >> 32));
+    return f == (fingerprints_[Slot(x, 0)] ^ fingerprints_[Slot(x, 1)] ^
+                 fingerprints_[Slot(x, 2)]);
+  }
+
+  size_t MemoryBytes() const { return fingerprints_.size(); }
+
+ private:
+  // 1.23 slots per key let the peeling below succeed with high probability,
+  // a failed attempt is retried with the next seed
+  void Build(std::vector<uint64_t> hashes) {
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    if (hashes.empty()) {
+      return;
+    }
+    block_ = (32 + hashes.size() * 123 / 100) / 3;
+    size_t slots = 3 * block_;
+    std::vector<uint64_t> xors(slots);
+    std::vector<uint32_t> counts(slots);
+    std::vector<size_t> queue;
+    std::vector<std::pair<uint64_t, size_t>> order;
+    for (seed_ = 0;; ++seed_) {
+      std::fill(xors.begin(), xors.end(), 0);
+      std::fill(counts.begin(), counts.end(), 0);
+      for (uint64_t hash : hashes) {
+        uint64_t x = FilterHash(hash + seed_);
+        for (int i = 0; i < 3; ++i) {
+          xors[Slot(x, i)] ^= x;
+          ++counts[Slot(x, i)];
+        }
+      }
+      // peel slots owned by a single key until none are left
+      queue.clear();
+      order.clear();
+      for (size_t i = 0; i < slots; ++i) {
+        if (counts[i] == 1) {
+          queue.push_back(i);
+        }
+      }
+      while (!queue.empty()) {
+        size_t slot = queue.back();
+        queue.pop_back();
+        if (counts[slot] != 1) {
+          continue;
+        }
+        uint64_t x = xors[slot];
+        order.emplace_back(x, slot);
+        for (int i = 0; i < 3; ++i) {
+          size_t other = Slot(x, i);
+          xors[other] ^= x;
+          if (--counts[other] == 1) {
+            queue.push_back(other);
+          }
+        }
+      }
+      if (order.size() == hashes.size()) {
+        break;
+      }
+    }
+    // the last key peeled is the first one free to pick its byte
+    fingerprints_.assign(slots, 0);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+      auto [x, slot] = *it;
+      fingerprints_[slot] =
+          static_cast<uint8_t>(x ^ (x >> 32)) ^ fingerprints_[Slot(x, 0)] ^
+          fingerprints_[Slot(x, 1)] ^ fingerprints_[Slot(x, 2)];
+    }
+  }
+
+  size_t Slot(uint64_t x, int i) const {
+    uint32_t part = static_cast<uint32_t>(std::rotl(x, 21 * i));
+    return i * block_ + ((static_cast<uint64_t>(part) * block_) >> 32);
+  }
+
+  std::vector<uint8_t> fingerprints_;
+  size_t block_ = 0;
+  uint64_t seed_ = 0;
+};
+}  // namespace s21
+
+#endif
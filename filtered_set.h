@@ -0,0 +1,129 @@
+#ifndef FILTERED_SET_H
+#define FILTERED_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "filter.h"
+#include "set.h"
+#include "vector.h"
+
+namespace s21 {
+struct FilterStats {
+  size_t queries = 0;
+  // misses the filter answered without touching the tree
+  size_t rejected = 0;
+  // misses the filter let through to a tree descent
+  size_t false_positives = 0;
+  size_t memory_bytes = 0;
+  double bits_per_key = 0;
+
+  double false_positive_rate() const {
+    size_t misses = rejected + false_positives;
+    return misses ? static_cast<double>(false_positives) / misses : 0.0;
+  }
+};
+
+// s21::set with an approximate membership filter in front of the tree, for
+// loads where most lookups miss: find and contains ask the filter first and
+// only descend when it says the key may be there.
+//
+// While the set changes the filter is a blocked Bloom filter, rebuilt from
+// the tree when it fills up or when the erased keys it still reports
+// outnumber the live ones. freeze() swaps it for an xor filter, smaller and
+// with fewer false positives; erase leaves a frozen filter alone, the next
+// insert thaws it back into a Bloom filter. Lookups update the stats, so
+// like cached_set they are not safe to call from several threads at once.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Hash = std::hash<Key>>
+class filtered_set {
+ public:
+  using set_type = set<Key, Compare>;
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename set_type::iterator;
+  using const_iterator = typename set_type::const_iterator;
+  using size_type = size_t;
+  using node_type = typename set_type::node_type;
+
+  // bits_per_key sizes the Bloom filter, 12 gives about 0.5% false positives
+  explicit filtered_set(size_type bits_per_key = 12);
+  filtered_set(std::initializer_list<value_type> const &items);
+  filtered_set(const filtered_set &other) = default;
+  // the moved-from set is left as a default-constructed one
+  filtered_set(filtered_set &&other);
+  ~filtered_set() = default;
+  filtered_set &operator=(const filtered_set &other) = default;
+  filtered_set &operator=(filtered_set &&other);
+
+  iterator begin() { return set_.begin(); }
+  const_iterator begin() const { return set_.begin(); }
+  iterator end() { return set_.end(); }
+  const_iterator end() const { return set_.end(); }
+
+  bool empty() const { return set_.empty(); }
+  size_type size() const { return size_; }
+  size_type max_size() const { return set_.max_size(); }
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  template <typename... Args>
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
+  void erase(iterator pos);
+  size_type erase(const key_type &key);
+  node_type extract(iterator pos);
+  void swap(filtered_set &other);
+  void merge(filtered_set &other);
+
+  iterator find(const key_type &key);
+  bool contains(const key_type &key) { return find(key) != end(); }
+  size_type count(const key_type &key) { return contains(key); }
+  iterator lower_bound(const key_type &key) { return set_.lower_bound(key); }
+  iterator upper_bound(const key_type &key) { return set_.upper_bound(key); }
+
+  // the plain tree, lookups through it skip the filter
+  const set_type &base() const { return set_; }
+
+  // replaces the Bloom filter with an xor filter built from the current keys
+  void freeze();
+  bool frozen() const { return frozen_; }
+
+  FilterStats filter_stats() const;
+  void reset_filter_stats() { stats_ = FilterStats(); }
+
+  bool validate() const;
+
+ private:
+  uint64_t HashOf(const key_type &key) const { return FilterHash(hash_(key)); }
+  bool MayContain(uint64_t hash) const {
+    return frozen_ ? xor_.MayContain(hash) : bloom_.MayContain(hash);
+  }
+  // builds a Bloom filter for at least capacity keys from the tree
+  void Rebuild(size_type capacity);
+  // counts a key the filter can no longer forget
+  void Forget();
+
+  set_type set_;
+  // set::size counts the nodes, the filter needs the size on every insert
+  size_type size_ = 0;
+  BloomFilter bloom_;
+  XorFilter xor_;
+  bool frozen_ = false;
+  size_type bits_per_key_ = 12;
+  // erased keys the Bloom filter still answers maybe for
+  size_type stale_ = 0;
+  FilterStats stats_;
+  [[no_unique_address]] Hash hash_;
+};
+}  // namespace s21
+
+#include "filtered_set.tpp"
+
+#endif
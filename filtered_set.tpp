@@ -0,0 +1,197 @@
+#include <algorithm>
+
+#include "filtered_set.h"
+
+template <typename Key, typename Compare, typename Hash>
+s21::filtered_set<Key, Compare, Hash>::filtered_set(size_type bits_per_key)
+    : bits_per_key_(std::max<size_type>(bits_per_key, 1)) {}
+
+template <typename Key, typename Compare, typename Hash>
+s21::filtered_set<Key, Compare, Hash>::filtered_set(
+    std::initializer_list<value_type> const &items)
+    : filtered_set() {
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename Compare, typename Hash>
+s21::filtered_set<Key, Compare, Hash>::filtered_set(filtered_set &&other)
+    : filtered_set() {
+  swap(other);
+}
+
+template <typename Key, typename Compare, typename Hash>
+s21::filtered_set<Key, Compare, Hash> &
+s21::filtered_set<Key, Compare, Hash>::operator=(filtered_set &&other) {
+  if (this != &other) {
+    filtered_set moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::filtered_set<Key, Compare, Hash>::clear() {
+  set_.clear();
+  size_ = 0;
+  bloom_ = BloomFilter();
+  xor_ = XorFilter();
+  frozen_ = false;
+  stale_ = 0;
+}
+
+template <typename Key, typename Compare, typename Hash>
+std::pair<typename s21::filtered_set<Key, Compare, Hash>::iterator, bool>
+s21::filtered_set<Key, Compare, Hash>::insert(const value_type &value) {
+  auto res = set_.insert(value);
+  if (!res.second) {
+    return res;
+  }
+  ++size_;
+  if (frozen_ || size_ > bloom_.Capacity()) {
+    Rebuild(size_ * 2);
+  } else {
+    bloom_.Insert(HashOf(value));
+  }
+  return res;
+}
+
+template <typename Key, typename Compare, typename Hash>
+template <typename... Args>
+s21::vector<
+    std::pair<typename s21::filtered_set<Key, Compare, Hash>::iterator, bool>,
+    sizeof...(Args)>
+s21::filtered_set<Key, Compare, Hash>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
+  (results.push_back(insert(std::forward<Args>(args))), ...);
+  return results;
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::filtered_set<Key, Compare, Hash>::erase(iterator pos) {
+  set_.erase(pos);
+  --size_;
+  Forget();
+}
+
+template <typename Key, typename Compare, typename Hash>
+typename s21::filtered_set<Key, Compare, Hash>::size_type
+s21::filtered_set<Key, Compare, Hash>::erase(const key_type &key) {
+  iterator pos = find(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase(pos);
+  return 1;
+}
+
+template <typename Key, typename Compare, typename Hash>
+typename s21::filtered_set<Key, Compare, Hash>::node_type
+s21::filtered_set<Key, Compare, Hash>::extract(iterator pos) {
+  node_type res = set_.extract(pos);
+  --size_;
+  Forget();
+  return res;
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::filtered_set<Key, Compare, Hash>::swap(filtered_set &other) {
+  set_.swap(other.set_);
+  std::swap(size_, other.size_);
+  std::swap(bloom_, other.bloom_);
+  std::swap(xor_, other.xor_);
+  std::swap(frozen_, other.frozen_);
+  std::swap(bits_per_key_, other.bits_per_key_);
+  std::swap(stale_, other.stale_);
+  std::swap(stats_, other.stats_);
+  std::swap(hash_, other.hash_);
+}
+
+// the keys that moved over all need bits here, so the filter is rebuilt
+// once instead of growing key by key; merge walks both trees anyway, so
+// the sizes are recounted
+template <typename Key, typename Compare, typename Hash>
+void s21::filtered_set<Key, Compare, Hash>::merge(filtered_set &other) {
+  if (this == &other) {
+    return;
+  }
+  set_.merge(other.set_);
+  size_type moved = set_.size() - size_;
+  if (moved) {
+    size_ += moved;
+    other.size_ -= moved;
+    Rebuild(size_ * 2);
+    other.stale_ += moved - 1;
+    other.Forget();
+  }
+}
+
+template <typename Key, typename Compare, typename Hash>
+typename s21::filtered_set<Key, Compare, Hash>::iterator
+s21::filtered_set<Key, Compare, Hash>::find(const key_type &key) {
+  ++stats_.queries;
+  if (!MayContain(HashOf(key))) {
+    ++stats_.rejected;
+    return end();
+  }
+  iterator res = set_.find(key);
+  if (res == end()) {
+    ++stats_.false_positives;
+  }
+  return res;
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::filtered_set<Key, Compare, Hash>::freeze() {
+  std::vector<uint64_t> hashes;
+  hashes.reserve(size_);
+  for (const auto &key : set_) {
+    hashes.push_back(HashOf(key));
+  }
+  xor_ = XorFilter(std::move(hashes));
+  bloom_ = BloomFilter();
+  frozen_ = true;
+  stale_ = 0;
+}
+
+template <typename Key, typename Compare, typename Hash>
+s21::FilterStats s21::filtered_set<Key, Compare, Hash>::filter_stats() const {
+  FilterStats res = stats_;
+  res.memory_bytes = frozen_ ? xor_.MemoryBytes() : bloom_.MemoryBytes();
+  if (!set_.empty()) {
+    res.bits_per_key = 8.0 * res.memory_bytes / size_;
+  }
+  return res;
+}
+
+// a filter may err towards maybe but must never reject a key of the tree
+template <typename Key, typename Compare, typename Hash>
+bool s21::filtered_set<Key, Compare, Hash>::validate() const {
+  for (const auto &key : set_) {
+    if (!MayContain(HashOf(key))) {
+      return false;
+    }
+  }
+  return set_.validate();
+}
+
+template <typename Key, typename Compare, typename Hash>
+void s21::filtered_set<Key, Compare, Hash>::Rebuild(size_type capacity) {
+  bloom_ = BloomFilter(std::max<size_type>(capacity, 64), bits_per_key_);
+  for (const auto &key : set_) {
+    bloom_.Insert(HashOf(key));
+  }
+  xor_ = XorFilter();
+  frozen_ = false;
+  stale_ = 0;
+}
+
+// an xor filter only gains a false positive, a Bloom filter is rebuilt once
+// the stale keys outnumber the live ones, which keeps erase amortized O(1)
+template <typename Key, typename Compare, typename Hash>
+void s21::filtered_set<Key, Compare, Hash>::Forget() {
+  if (!frozen_ && ++stale_ > size_) {
+    Rebuild(size_ * 2);
+  }
+}
@@ -0,0 +1,366 @@
+// Differential fuzzer for set and multiset: long mixed sequences of
+// operations run on two s21 containers and on two std ones side by side,
+// every answer is compared, and after every step both s21 trees must pass
+// validate() and hold the same keys as their std twins. The first failed
+// check prints the step and aborts.
+//
+// Built plainly (make fuzz) main runs random inputs from a seed that it
+// prints, so a failure can be replayed with ./fuzzer <runs> <seed>; built
+// with -DS21_LIBFUZZER -fsanitize=fuzzer, libFuzzer drives the same entry
+// point. At exit the time spent per operation on each side is reported.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <set>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "multiset.h"
+#include "set.h"
+
+namespace {
+enum Op {
+  kInsert,
+  kErase,
+  kFind,
+  kLowerBound,
+  kUpperBound,
+  kCount,
+  kFingerSearch,
+  kLookupMany,
+  kMerge,
+  kSwap,
+  kCopy,
+  kMove,
+  kExtract,
+  kClear,
+  kOps
+};
+
+const char *const kOpNames[kOps] = {
+    "insert", "erase", "find",  "lower_bound", "upper_bound",
+    "count",  "finger_search",  "lookup_many", "merge",
+    "swap",   "copy",  "move",  "extract",     "clear"};
+
+struct OpTimes {
+  size_t calls = 0;
+  double s21_ns = 0;
+  double std_ns = 0;
+};
+
+OpTimes op_times[kOps];
+const char *current_container = "";
+size_t current_step = 0;
+Op current_op = kInsert;
+
+[[noreturn]] void Fail(const char *what, int line) {
+  std::fprintf(stderr, "fuzz: %s failed at fuzz.cpp:%d, step %zu (%s on %s)\n",
+               what, line, current_step, kOpNames[current_op],
+               current_container);
+  std::abort();
+}
+
+#define FUZZ_CHECK(cond)   \
+  do {                     \
+    if (!(cond)) {         \
+      Fail(#cond, __LINE__); \
+    }                      \
+  } while (0)
+
+// the fuzzer input read a byte at a time
+class Input {
+ public:
+  Input(const uint8_t *data, size_t size) : cur_(data), end_(data + size) {}
+
+  bool Done() const { return cur_ == end_; }
+  // zeros once the input runs out
+  uint8_t Byte() { return cur_ == end_ ? 0 : *cur_++; }
+
+ private:
+  const uint8_t *cur_;
+  const uint8_t *end_;
+};
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// runs mine on the s21 side and theirs on the std side, timing each
+template <typename Mine, typename Theirs>
+void Run(Op op, Mine mine, Theirs theirs) {
+  ++op_times[op].calls;
+  auto start = std::chrono::steady_clock::now();
+  mine();
+  op_times[op].s21_ns += Since(start);
+  start = std::chrono::steady_clock::now();
+  theirs();
+  op_times[op].std_ns += Since(start);
+}
+
+// position of it in c, so that lower_bound and friends are compared by
+// where they point and not only by the key there
+template <typename C, typename It>
+size_t PositionOf(const C &c, It it) {
+  return std::distance(c.begin(), it);
+}
+
+// S is s21::set or s21::multiset, Std its std counterpart
+template <typename S, typename Std, bool Multi>
+class Differential {
+ public:
+  void Step(Input &in) {
+    current_op = static_cast<Op>(in.Byte() % kOps);
+    size_t i = in.Byte() & 1;
+    int key = in.Byte();
+    S &a = s21_[i];
+    S &b = s21_[1 - i];
+    Std &sa = std_[i];
+    Std &sb = std_[1 - i];
+    const S &ca = a;
+
+    switch (current_op) {
+      case kInsert: {
+        bool mine = true, theirs = true;
+        int at = -1;
+        Run(
+            kInsert,
+            [&] {
+              if constexpr (Multi) {
+                at = *a.insert(key);
+              } else {
+                auto res = a.insert(key);
+                mine = res.second;
+                at = *res.first;
+              }
+            },
+            [&] {
+              if constexpr (Multi) {
+                sa.insert(key);
+              } else {
+                theirs = sa.insert(key).second;
+              }
+            });
+        FUZZ_CHECK(mine == theirs);
+        FUZZ_CHECK(at == key);
+        break;
+      }
+      case kErase: {
+        bool mine = false, theirs = false;
+        Run(
+            kErase,
+            [&] {
+              auto it = a.find(key);
+              if ((mine = it != a.end())) {
+                a.erase(it);
+              }
+            },
+            [&] {
+              auto it = sa.find(key);
+              if ((theirs = it != sa.end())) {
+                sa.erase(it);
+              }
+            });
+        FUZZ_CHECK(mine == theirs);
+        break;
+      }
+      case kFind: {
+        typename S::const_iterator mine;
+        typename Std::const_iterator theirs;
+        Run(
+            kFind, [&] { mine = ca.find(key); },
+            [&] { theirs = sa.find(key); });
+        FUZZ_CHECK((mine == ca.end()) == (theirs == sa.end()));
+        FUZZ_CHECK(mine == ca.end() || *mine == key);
+        // a multiset finds the first of the copies
+        FUZZ_CHECK(mine == ca.end() ||
+                   PositionOf(ca, mine) ==
+                       PositionOf(sa, sa.lower_bound(key)));
+        break;
+      }
+      case kLowerBound:
+      case kUpperBound: {
+        typename S::const_iterator mine;
+        typename Std::const_iterator theirs;
+        bool lower = current_op == kLowerBound;
+        Run(
+            current_op,
+            [&] { mine = lower ? ca.lower_bound(key) : ca.upper_bound(key); },
+            [&] {
+              theirs = lower ? sa.lower_bound(key) : sa.upper_bound(key);
+            });
+        FUZZ_CHECK(PositionOf(ca, mine) == PositionOf(sa, theirs));
+        break;
+      }
+      case kCount: {
+        size_t mine = 0, theirs = 0;
+        bool mine_contains = false;
+        Run(
+            kCount,
+            [&] {
+              mine = ca.count(key);
+              mine_contains = ca.contains(key);
+            },
+            [&] { theirs = sa.count(key); });
+        FUZZ_CHECK(mine == theirs);
+        FUZZ_CHECK(mine_contains == (theirs != 0));
+        break;
+      }
+      case kFingerSearch: {
+        // std has no finger search, its answers come from the root
+        auto finger = ca.lower_bound(in.Byte());
+        typename S::const_iterator lower, found;
+        typename Std::const_iterator std_lower, std_found;
+        Run(
+            kFingerSearch,
+            [&] {
+              lower = ca.lower_bound_from(finger, key);
+              found = ca.find_from(finger, key);
+            },
+            [&] {
+              std_lower = sa.lower_bound(key);
+              std_found = sa.find(key);
+            });
+        FUZZ_CHECK(PositionOf(ca, lower) == PositionOf(sa, std_lower));
+        FUZZ_CHECK((found == ca.end()) == (std_found == sa.end()));
+        FUZZ_CHECK(found == ca.end() || found == lower);
+        break;
+      }
+      case kLookupMany: {
+        std::vector<int> keys(in.Byte() % 32);
+        for (int &k : keys) {
+          k = in.Byte();
+        }
+        size_t width = 1 + in.Byte() % 8;
+        std::vector<typename S::const_iterator> mine;
+        std::vector<bool> theirs;
+        Run(
+            kLookupMany, [&] { mine = ca.lookup_many(keys, width); },
+            [&] {
+              for (int k : keys) {
+                theirs.push_back(sa.find(k) != sa.end());
+              }
+            });
+        FUZZ_CHECK(mine.size() == keys.size());
+        for (size_t j = 0; j < keys.size(); ++j) {
+          FUZZ_CHECK(mine[j] == ca.find(keys[j]));
+          FUZZ_CHECK((mine[j] != ca.end()) == theirs[j]);
+        }
+        break;
+      }
+      case kMerge:
+        Run(kMerge, [&] { a.merge(b); }, [&] { sa.merge(sb); });
+        break;
+      case kSwap:
+        Run(kSwap, [&] { a.swap(b); }, [&] { sa.swap(sb); });
+        break;
+      case kCopy:
+        Run(kCopy, [&] { b = S(a); }, [&] { sb = sa; });
+        break;
+      case kMove:
+        Run(
+            kMove, [&] { b = std::move(a); }, [&] { sb = std::move(sa); });
+        // a moved-from s21 container is empty, a std one only valid
+        FUZZ_CHECK(a.empty());
+        sa.clear();
+        break;
+      case kExtract: {
+        bool mine = false, theirs = false;
+        Run(
+            kExtract,
+            [&] {
+              auto nh = a.extract(key);
+              mine = !nh.empty();
+              FUZZ_CHECK(!mine || nh.value() == key);
+              b.insert(std::move(nh));
+            },
+            [&] {
+              auto nh = sa.extract(key);
+              theirs = !nh.empty();
+              sb.insert(std::move(nh));
+            });
+        FUZZ_CHECK(mine == theirs);
+        break;
+      }
+      case kClear:
+        Run(kClear, [&] { a.clear(); }, [&] { sa.clear(); });
+        break;
+      case kOps:
+        break;
+    }
+    Check();
+  }
+
+ private:
+  void Check() const {
+    for (size_t i = 0; i < 2; ++i) {
+      FUZZ_CHECK(s21_[i].validate());
+      FUZZ_CHECK(s21_[i].size() == std_[i].size());
+      FUZZ_CHECK(std::equal(s21_[i].begin(), s21_[i].end(), std_[i].begin(),
+                            std_[i].end()));
+    }
+  }
+
+  S s21_[2];
+  Std std_[2];
+};
+
+template <typename S, typename Std, bool Multi>
+void Replay(const char *name, const uint8_t *data, size_t size) {
+  current_container = name;
+  Input in(data, size);
+  Differential<S, Std, Multi> differential;
+  for (current_step = 0; !in.Done(); ++current_step) {
+    differential.Step(in);
+  }
+}
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  Replay<s21::set<int>, std::set<int>, false>("set", data, size);
+  Replay<s21::multiset<int>, std::multiset<int>, true>("multiset", data,
+                                                       size);
+  return 0;
+}
+
+#ifndef S21_LIBFUZZER
+// ./fuzzer [runs] [seed]: runs random inputs of 4 KiB each
+int main(int argc, char **argv) {
+  size_t runs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+  uint64_t seed =
+      argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::random_device()();
+  std::printf("fuzz: %zu runs, seed %llu\n", runs,
+              static_cast<unsigned long long>(seed));
+  std::mt19937_64 gen(seed);
+  std::vector<uint8_t> data(4096);
+  for (size_t run = 0; run < runs; ++run) {
+    for (auto &byte : data) {
+      byte = static_cast<uint8_t>(gen());
+    }
+    LLVMFuzzerTestOneInput(data.data(), data.size());
+  }
+
+  std::printf("%-14s %10s %12s %12s %8s\n", "operation", "calls",
+              "s21 Mops/s", "std Mops/s", "s21/std");
+  for (int op = 0; op < kOps; ++op) {
+    const OpTimes &t = op_times[op];
+    if (!t.calls) {
+      continue;
+    }
+    double mine = t.calls / t.s21_ns * 1e3;
+    double theirs = t.calls / t.std_ns * 1e3;
+    std::printf("%-14s %10zu %12.2f %12.2f %8.2f\n", kOpNames[op], t.calls,
+                mine, theirs, mine / theirs);
+  }
+  std::printf("fuzz: all checks passed\n");
+  return 0;
+}
+#endif
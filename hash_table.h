@@ -0,0 +1,497 @@
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+namespace s21 {
+// Key taken out of a hash table by extract, it can be inserted back into a
+// table of the same key type.
+template <typename Key>
+class HashNodeHandle {
+ public:
+  using value_type = Key;
+
+  HashNodeHandle() = default;
+  explicit HashNodeHandle(Key &&key) : key_(std::move(key)) {}
+  HashNodeHandle(const HashNodeHandle &) = delete;
+  HashNodeHandle(HashNodeHandle &&other) noexcept = default;
+
+  HashNodeHandle &operator=(const HashNodeHandle &) = delete;
+  HashNodeHandle &operator=(HashNodeHandle &&other) noexcept = default;
+
+  bool empty() const { return !key_.has_value(); }
+  explicit operator bool() const { return key_.has_value(); }
+  value_type &value() { return *key_; }
+  const value_type &value() const { return *key_; }
+
+  // empties the handle after its key was moved into a table
+  void Reset() { key_.reset(); }
+
+ private:
+  std::optional<Key> key_;
+};
+
+// Open-addressing table with Robin Hood probing over two flat arrays: one
+// control byte per slot holding the distance from the home slot plus one (0
+// marks an empty slot), and the keys themselves. Keys of a probe run stay
+// ordered by home slot, so a lookup stops as soon as it meets a key closer to
+// its home than the probe is, and erase shifts the rest of the run back by
+// one instead of leaving a tombstone.
+//
+// The arrays carry an overflow tail past the last home slot instead of
+// wrapping around, so iteration order is plain slot order and equal keys of
+// a multi table are adjacent. An insert that would need a distance over
+// kMaxDistance or run off the tail grows the table, unless kMaxDistance
+// keys already share its mixed hash: those keys share a home at every size,
+// so growing cannot help and the insert throws std::length_error instead.
+template <typename Key, typename Hash, typename KeyEqual>
+class HashTable {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    const uint8_t *ctrl_ = nullptr;
+    const Key *slot_ = nullptr;
+
+    Iterator() = default;
+    Iterator(const uint8_t *ctrl, const Key *slot)
+        : ctrl_(ctrl), slot_(slot) {}
+
+    reference operator*() const { return *slot_; }
+    pointer operator->() const { return slot_; }
+
+    // the control byte past the last slot is never 0, so no bound check
+    Iterator &operator++() {
+      do {
+        ++ctrl_;
+        ++slot_;
+      } while (*ctrl_ == 0);
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return ctrl_ == other.ctrl_;
+    }
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+  };
+
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+ protected:
+  static constexpr uint8_t kMaxDistance = 255;
+  static constexpr size_t kMinBuckets = 8;
+  static constexpr size_t kMaxEqual = 128;
+
+  // where a key is or would go: found_ is its slot or npos, pos_ and dist_
+  // the slot and control byte a new key takes
+  struct ProbePos {
+    size_t found_;
+    size_t pos_;
+    size_t dist_;
+  };
+
+  HashTable() = default;
+  HashTable(const HashTable &other) : hash_(other.hash_), eq_(other.eq_) {
+    if (other.size_) {
+      Allocate(other.buckets_);
+      for (size_t i = 0; i < total_; ++i) {
+        if (other.ctrl_[i]) {
+          ::new (static_cast<void *>(slots_ + i)) Key(other.slots_[i]);
+          ctrl_[i] = other.ctrl_[i];
+          ++size_;
+        }
+      }
+    }
+  }
+  HashTable(HashTable &&other) noexcept { Swap(other); }
+  ~HashTable() {
+    Clear();
+    Free();
+  }
+
+  HashTable &operator=(HashTable other) noexcept {
+    Swap(other);
+    return *this;
+  }
+
+  // the first key at or after slot i
+  Iterator Next(size_t i) const {
+    while (ctrl_[i] == 0) {
+      ++i;
+    }
+    return At(i);
+  }
+  Iterator Begin() const { return Next(0); }
+  Iterator End() const { return At(total_); }
+  Iterator At(size_t i) const { return Iterator(ctrl_ + i, slots_ + i); }
+  size_t IndexOf(Iterator it) const { return it.ctrl_ - ctrl_; }
+  Key &SlotAt(size_t i) { return slots_[i]; }
+
+  size_t Size() const { return size_; }
+  size_t Buckets() const { return buckets_; }
+  static size_t MaxSize() {
+    return std::numeric_limits<size_t>::max() / (sizeof(Key) + 1) / 2;
+  }
+
+  // Fibonacci hashing: the top bits of the product spread weak hashes such
+  // as the identity hash of integers over all buckets
+  template <typename K>
+  uint64_t Mixed(const K &key) const {
+    return static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ull;
+  }
+  template <typename K>
+  size_t Home(const K &key) const {
+    return Mixed(key) >> shift_;
+  }
+
+  template <typename K>
+  size_t Find(const K &key) const {
+    if (size_ == 0) {
+      return npos;
+    }
+    size_t i = Home(key);
+    for (size_t dist = 1; ctrl_[i] >= dist; ++i, ++dist) {
+      if (ctrl_[i] == dist && eq_(slots_[i], key)) {
+        return i;
+      }
+    }
+    return npos;
+  }
+
+  // [first, last) slots of the keys equal to key
+  template <typename K>
+  std::pair<size_t, size_t> EqualRange(const K &key) const {
+    size_t first = Find(key);
+    if (first == npos) {
+      return std::make_pair(total_, total_);
+    }
+    size_t last = first + 1;
+    while (ctrl_[last] == ctrl_[first] + (last - first) &&
+           eq_(slots_[last], key)) {
+      ++last;
+    }
+    return std::make_pair(first, last);
+  }
+
+  ProbePos FindUniquePos(const Key &key) const {
+    if (buckets_ == 0) {
+      return ProbePos{npos, npos, 0};
+    }
+    size_t i = Home(key);
+    size_t dist = 1;
+    for (; ctrl_[i] >= dist; ++i, ++dist) {
+      if (ctrl_[i] == dist && eq_(slots_[i], key)) {
+        return ProbePos{i, i, dist};
+      }
+    }
+    return ProbePos{npos, i, dist};
+  }
+
+  // the slot right after the last key equal to key, so equal keys stay
+  // adjacent in insertion order; found_ is the first of them or npos
+  ProbePos FindEqualPos(const Key &key) const {
+    if (buckets_ == 0) {
+      return ProbePos{npos, npos, 0};
+    }
+    size_t i = Home(key);
+    size_t dist = 1;
+    size_t found = npos;
+    for (; ctrl_[i] >= dist; ++i, ++dist) {
+      if (ctrl_[i] == dist && eq_(slots_[i], key)) {
+        if (found == npos) {
+          found = i;
+        }
+      } else if (found != npos) {
+        break;
+      }
+    }
+    return ProbePos{found, i, dist};
+  }
+
+  // puts value at pos.pos_, shifting the rest of the run one slot on;
+  // returns npos and leaves value alone when the table must grow first
+  size_t Place(const ProbePos &pos, Key &&value) {
+    if (pos.pos_ == npos || (size_ + 1) * 5 > buckets_ * 4 ||
+        pos.dist_ > kMaxDistance) {
+      return npos;
+    }
+    size_t empty = pos.pos_;
+    while (ctrl_[empty]) {
+      if (ctrl_[empty] == kMaxDistance) {
+        return npos;
+      }
+      ++empty;
+    }
+    if (empty == total_) {
+      return npos;
+    }
+    for (size_t i = empty; i > pos.pos_; --i) {
+      ctrl_[i] = ctrl_[i - 1] + 1;
+    }
+    Relocate(slots_ + pos.pos_, empty - pos.pos_, slots_ + pos.pos_ + 1);
+    ::new (static_cast<void *>(slots_ + pos.pos_)) Key(std::move(value));
+    ctrl_[pos.pos_] = static_cast<uint8_t>(pos.dist_);
+    ++size_;
+    return pos.pos_;
+  }
+
+  // inserts a key known to be absent, or any key into a multi table
+  size_t InsertNew(Key &&value, bool multi) {
+    size_t res = npos;
+    while (res == npos) {
+      ProbePos pos = multi ? FindEqualPos(value) : FindUniquePos(value);
+      // a run of equal keys shares one home, growing cannot shorten it
+      if (pos.found_ != npos && pos.pos_ - pos.found_ >= kMaxEqual) {
+        throw std::length_error("hash table: too many equal keys");
+      }
+      res = Place(pos, std::move(value));
+      if (res == npos) {
+        if (pos.pos_ != npos && (size_ + 1) * 5 <= buckets_ * 4 &&
+            SharedHashes(value) >= kMaxDistance) {
+          throw std::length_error("hash table: too many keys with one hash");
+        }
+        Rehash(std::max(buckets_ * 2, kMinBuckets));
+      }
+    }
+    return res;
+  }
+
+  // keys in the probe window of key with the same mixed hash; they stay in
+  // one run whatever the size of the table
+  size_t SharedHashes(const Key &key) const {
+    uint64_t mixed = Mixed(key);
+    size_t home = Home(key);
+    size_t last = std::min(total_, home + kMaxDistance);
+    size_t res = 0;
+    for (size_t i = home; i < last; ++i) {
+      res += ctrl_[i] && Mixed(slots_[i]) == mixed;
+    }
+    return res;
+  }
+
+  // slot of value and whether it went in, value is copied or moved only
+  // when it is absent
+  template <typename K>
+  std::pair<size_t, bool> InsertUnique(K &&value) {
+    ProbePos pos = FindUniquePos(value);
+    if (pos.found_ != npos) {
+      return std::make_pair(pos.found_, false);
+    }
+    Key key(std::forward<K>(value));
+    size_t res = Place(pos, std::move(key));
+    if (res == npos) {
+      res = InsertNew(std::move(key), false);
+    }
+    return std::make_pair(res, true);
+  }
+
+  // backward-shift deletion: the rest of the run moves one slot closer to
+  // home, so no tombstone is left behind
+  void EraseAt(size_t i) {
+    std::destroy_at(slots_ + i);
+    size_t last = i + 1;
+    while (ctrl_[last] > 1) {
+      ctrl_[last - 1] = ctrl_[last] - 1;
+      ++last;
+    }
+    Relocate(slots_ + i + 1, last - i - 1, slots_ + i);
+    ctrl_[last - 1] = 0;
+    --size_;
+  }
+
+  void Clear() {
+    if (size_) {
+      for (size_t i = 0; i < total_; ++i) {
+        if (ctrl_[i]) {
+          std::destroy_at(slots_ + i);
+          ctrl_[i] = 0;
+        }
+      }
+      size_ = 0;
+    }
+  }
+
+  // room for n keys without growing
+  void Reserve(size_t n) {
+    size_t buckets = std::max(buckets_, kMinBuckets);
+    while (n * 5 > buckets * 4) {
+      buckets *= 2;
+    }
+    if (buckets != buckets_) {
+      Rehash(buckets);
+    }
+  }
+
+  // moves every key to a table of the given power-of-two bucket count, or
+  // of more buckets if the keys do not fit in it. The keys go in sorted by
+  // hash and then by slot, each right after the one before or at its home,
+  // so equal keys stay together and in order. The hashes are all taken
+  // before the first key moves, and keys whose move may throw are copied,
+  // so a throw leaves the table as it was.
+  void Rehash(size_t buckets) {
+    vector<std::pair<uint64_t, size_t>> order;
+    order.reserve(size_);
+    for (size_t i = 0; i < total_; ++i) {
+      if (ctrl_[i]) {
+        order.push_back(std::make_pair(Mixed(slots_[i]), i));
+      }
+    }
+    std::sort(order.begin(), order.end());
+    while (!Fits(order, buckets)) {
+      buckets *= 2;
+    }
+    HashTable fresh;
+    fresh.hash_ = hash_;
+    fresh.eq_ = eq_;
+    fresh.Allocate(buckets);
+    size_t next = 0;
+    for (const auto &[mixed, i] : order) {
+      size_t home = mixed >> fresh.shift_;
+      size_t slot = std::max(home, next);
+      ::new (static_cast<void *>(fresh.slots_ + slot))
+          Key(std::move_if_noexcept(slots_[i]));
+      fresh.ctrl_[slot] = static_cast<uint8_t>(slot - home + 1);
+      ++fresh.size_;
+      next = slot + 1;
+    }
+    Clear();
+    Swap(fresh);
+  }
+
+  // whether the keys in order fit in a table of the given bucket count
+  // without a run going past the last slot or kMaxDistance
+  static bool Fits(const vector<std::pair<uint64_t, size_t>> &order,
+                   size_t buckets) {
+    if (buckets > MaxSize()) {
+      throw std::length_error("hash table: size exceeds max_size");
+    }
+    if (order.size() * 5 > buckets * 4) {
+      return false;
+    }
+    int shift = 64 - std::countr_zero(static_cast<uint64_t>(buckets));
+    size_t total = buckets + std::min<size_t>(buckets, kMaxDistance);
+    size_t next = 0;
+    for (const auto &entry : order) {
+      size_t home = entry.first >> shift;
+      size_t slot = std::max(home, next);
+      if (slot >= total || slot - home >= kMaxDistance) {
+        return false;
+      }
+      next = slot + 1;
+    }
+    return true;
+  }
+
+  void Swap(HashTable &other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(buckets_, other.buckets_);
+    std::swap(total_, other.total_);
+    std::swap(shift_, other.shift_);
+    std::swap(size_, other.size_);
+    std::swap(hash_, other.hash_);
+    std::swap(eq_, other.eq_);
+  }
+
+  // every key sits at or after its home slot with the matching control byte,
+  // runs are ordered by home slot and the size matches
+  bool Validate() const {
+    size_t count = 0;
+    for (size_t i = 0; i < total_; ++i) {
+      if (ctrl_[i]) {
+        ++count;
+        if (Home(slots_[i]) + ctrl_[i] - 1 != i ||
+            (i > 0 && ctrl_[i] > ctrl_[i - 1] + 1)) {
+          return false;
+        }
+      }
+    }
+    return count == size_ && ctrl_[total_] == 1;
+  }
+
+  // the longest probe a lookup of a present key makes
+  size_t MaxProbe() const {
+    size_t res = 0;
+    for (size_t i = 0; i < total_; ++i) {
+      res = std::max<size_t>(res, ctrl_[i]);
+    }
+    return res;
+  }
+
+  const Hash &GetHash() const { return hash_; }
+  const KeyEqual &GetKeyEqual() const { return eq_; }
+
+ private:
+  static void Relocate(Key *from, size_t n, Key *to) {
+    if constexpr (is_trivially_relocatable_v<Key>) {
+      if (n) {
+        std::memmove(static_cast<void *>(to), static_cast<void *>(from),
+                     n * sizeof(Key));
+      }
+    } else if (to < from) {
+      for (size_t i = 0; i < n; ++i) {
+        ::new (static_cast<void *>(to + i)) Key(std::move(from[i]));
+        std::destroy_at(from + i);
+      }
+    } else {
+      for (size_t i = n; i-- > 0;) {
+        ::new (static_cast<void *>(to + i)) Key(std::move(from[i]));
+        std::destroy_at(from + i);
+      }
+    }
+  }
+
+  void Allocate(size_t buckets) {
+    buckets_ = buckets;
+    total_ = buckets + std::min<size_t>(buckets, kMaxDistance);
+    shift_ = 64 - std::countr_zero(static_cast<uint64_t>(buckets));
+    ctrl_ = new uint8_t[total_ + 1]();
+    ctrl_[total_] = 1;
+    slots_ = std::allocator<Key>().allocate(total_);
+  }
+
+  void Free() {
+    if (buckets_) {
+      delete[] ctrl_;
+      std::allocator<Key>().deallocate(slots_, total_);
+    }
+  }
+
+  // an empty table points at a lone end marker and allocates nothing
+  static inline uint8_t kEmptyCtrl[1] = {1};
+
+  uint8_t *ctrl_ = kEmptyCtrl;
+  Key *slots_ = nullptr;
+  size_t buckets_ = 0;
+  size_t total_ = 0;
+  int shift_ = 64;
+  size_t size_ = 0;
+  [[no_unique_address]] Hash hash_;
+  [[no_unique_address]] KeyEqual eq_;
+};
+}  // namespace s21
+
+#endif
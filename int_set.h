@@ -0,0 +1,171 @@
+#ifndef INT_SET_H
+#define INT_SET_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "vector.h"
+
+namespace s21 {
+// Ordered set of unsigned integers stored as a 64-ary bitmap trie: every
+// level consumes 6 bits of the key, a node keeps a 64-bit occupancy mask and
+// a compact array of its children ranked with popcount. Lookups touch at most
+// ceil(bits / 6) nodes (6 for uint32_t, 11 for uint64_t) and successors are
+// found with countr_zero on the masks instead of key comparisons.
+template <typename UInt>
+class int_set {
+  static_assert(std::is_unsigned_v<UInt>, "int_set needs an unsigned key");
+
+ public:
+  using key_type = UInt;
+  using value_type = UInt;
+  using size_type = size_t;
+
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = UInt;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const UInt *;
+    using reference = const UInt &;
+
+    Iterator() = default;
+    Iterator(const int_set *owner, UInt key, bool end)
+        : owner_(owner), key_(key), end_(end) {}
+
+    reference operator*() const { return key_; }
+    pointer operator->() const { return &key_; }
+
+    Iterator &operator++() {
+      if (!end_) {
+        end_ = !owner_->Successor(key_, &key_);
+      }
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    Iterator &operator--() {
+      if (end_) {
+        end_ = !owner_->Predecessor(std::numeric_limits<UInt>::max(), true,
+                                    &key_);
+      } else {
+        end_ = !owner_->Predecessor(key_, false, &key_);
+      }
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return end_ == other.end_ && (end_ || key_ == other.key_);
+    }
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+   private:
+    const int_set *owner_ = nullptr;
+    UInt key_ = 0;
+    bool end_ = true;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  int_set() = default;
+  int_set(std::initializer_list<value_type> const &items);
+  int_set(const int_set &s);
+  int_set(int_set &&s) noexcept;
+  ~int_set() { clear(); }
+  int_set &operator=(const int_set &s);
+  int_set &operator=(int_set &&s) noexcept;
+
+  iterator begin() const;
+  iterator end() const { return iterator(this, 0, true); }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return static_cast<size_type>(std::numeric_limits<UInt>::max());
+  }
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  template <typename... Args>
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
+  void erase(iterator pos) { erase(*pos); }
+  size_type erase(const key_type &key);
+  void swap(int_set &other);
+  void merge(int_set &other);
+
+  iterator find(const key_type &key) const {
+    return contains(key) ? iterator(this, key, false) : end();
+  }
+  bool contains(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+ private:
+  static constexpr int kBits = std::numeric_limits<UInt>::digits;
+  static constexpr int kLevels = (kBits + 5) / 6;
+
+  struct Node {
+    uint64_t bits_ = 0;
+    // children in slot order, unused on the last level
+    Node **child_ = nullptr;
+    uint32_t cap_ = 0;
+  };
+
+  static unsigned Digit(UInt key, int level) {
+    return static_cast<unsigned>(key >> (6 * level)) & 63u;
+  }
+  static unsigned Rank(const Node *node, unsigned digit) {
+    return std::popcount(node->bits_ & ((uint64_t(1) << digit) - 1));
+  }
+  static Node *Child(const Node *node, unsigned digit) {
+    return node->child_[Rank(node, digit)];
+  }
+  static uint64_t Above(unsigned digit) {
+    return digit == 63 ? 0 : ~uint64_t(0) << (digit + 1);
+  }
+  static uint64_t Below(unsigned digit) {
+    return (uint64_t(1) << digit) - 1;
+  }
+
+  static Node *AddChild(Node *node, unsigned digit);
+  static void RemoveChild(Node *node, unsigned digit);
+  static void DelNode(Node *node, int level);
+  static Node *CloneNode(const Node *node, int level);
+
+  static UInt Min(const Node *node, int level, UInt base);
+  static UInt Max(const Node *node, int level, UInt base);
+  static bool LowerBound(const Node *node, int level, UInt key, UInt base,
+                         UInt *res);
+  static bool Floor(const Node *node, int level, UInt key, UInt base,
+                    UInt *res);
+
+  // smallest element greater than key
+  bool Successor(UInt key, UInt *res) const;
+  // largest element below key, or not above it when inclusive
+  bool Predecessor(UInt key, bool inclusive, UInt *res) const;
+
+  Node *root_ = nullptr;
+  size_type size_ = 0;
+};
+}  // namespace s21
+
+#include "int_set.tpp"
+
+#endif
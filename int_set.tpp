@@ -0,0 +1,335 @@
+#include "int_set.h"
+
+template <typename UInt>
+s21::int_set<UInt>::int_set(std::initializer_list<value_type> const &items) {
+  for (const auto &elem : items) {
+    insert(elem);
+  }
+}
+
+template <typename UInt>
+s21::int_set<UInt>::int_set(const int_set &s)
+    : root_(s.root_ ? CloneNode(s.root_, kLevels - 1) : nullptr),
+      size_(s.size_) {}
+
+template <typename UInt>
+s21::int_set<UInt>::int_set(int_set &&s) noexcept
+    : root_(s.root_), size_(s.size_) {
+  s.root_ = nullptr;
+  s.size_ = 0;
+}
+
+template <typename UInt>
+s21::int_set<UInt> &s21::int_set<UInt>::operator=(const int_set &s) {
+  if (this != &s) {
+    int_set tmp(s);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename UInt>
+s21::int_set<UInt> &s21::int_set<UInt>::operator=(int_set &&s) noexcept {
+  if (this != &s) {
+    clear();
+    swap(s);
+  }
+  return *this;
+}
+
+template <typename UInt>
+typename s21::int_set<UInt>::iterator s21::int_set<UInt>::begin() const {
+  return root_ ? iterator(this, Min(root_, kLevels - 1, 0), false) : end();
+}
+
+template <typename UInt>
+void s21::int_set<UInt>::clear() {
+  if (root_) {
+    DelNode(root_, kLevels - 1);
+  }
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename UInt>
+std::pair<typename s21::int_set<UInt>::iterator, bool>
+s21::int_set<UInt>::insert(const value_type &value) {
+  if (!root_) {
+    root_ = new Node;
+  }
+
+  Node *cur = root_;
+  for (int level = kLevels - 1; level > 0; --level) {
+    unsigned digit = Digit(value, level);
+    cur = (cur->bits_ >> digit) & 1 ? Child(cur, digit) : AddChild(cur, digit);
+  }
+
+  uint64_t bit = uint64_t(1) << Digit(value, 0);
+  bool inserted = !(cur->bits_ & bit);
+  cur->bits_ |= bit;
+  size_ += inserted;
+
+  return std::make_pair(iterator(this, value, false), inserted);
+}
+
+template <typename UInt>
+template <typename... Args>
+s21::vector<std::pair<typename s21::int_set<UInt>::iterator, bool>,
+            sizeof...(Args)>
+s21::int_set<UInt>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
+
+  for (auto value : std::initializer_list<value_type>{args...}) {
+    results.push_back(insert(value));
+  }
+
+  return results;
+}
+
+template <typename UInt>
+typename s21::int_set<UInt>::size_type s21::int_set<UInt>::erase(
+    const key_type &key) {
+  Node *path[kLevels];
+  Node *cur = root_;
+  int level = kLevels - 1;
+
+  while (cur && level > 0) {
+    path[level] = cur;
+    unsigned digit = Digit(key, level);
+    cur = (cur->bits_ >> digit) & 1 ? Child(cur, digit) : nullptr;
+    --level;
+  }
+
+  size_type res = 0;
+  uint64_t bit = cur ? uint64_t(1) << Digit(key, 0) : 0;
+  if (cur && (cur->bits_ & bit)) {
+    cur->bits_ &= ~bit;
+    --size_;
+    res = 1;
+
+    // drop the nodes that became empty on the way back up
+    for (level = 1; level < kLevels && !cur->bits_; ++level) {
+      delete[] cur->child_;
+      delete cur;
+      cur = path[level];
+      RemoveChild(cur, Digit(key, level));
+    }
+    if (!root_->bits_) {
+      delete[] root_->child_;
+      delete root_;
+      root_ = nullptr;
+    }
+  }
+
+  return res;
+}
+
+template <typename UInt>
+void s21::int_set<UInt>::swap(int_set &other) {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+}
+
+template <typename UInt>
+void s21::int_set<UInt>::merge(int_set &other) {
+  if (this != &other) {
+    iterator it = other.begin();
+    while (it != other.end()) {
+      UInt key = *it;
+      ++it;
+      if (insert(key).second) {
+        other.erase(key);
+      }
+    }
+  }
+}
+
+template <typename UInt>
+bool s21::int_set<UInt>::contains(const key_type &key) const {
+  const Node *cur = root_;
+  for (int level = kLevels - 1; cur && level > 0; --level) {
+    unsigned digit = Digit(key, level);
+    cur = (cur->bits_ >> digit) & 1 ? Child(cur, digit) : nullptr;
+  }
+
+  return cur && ((cur->bits_ >> Digit(key, 0)) & 1);
+}
+
+template <typename UInt>
+typename s21::int_set<UInt>::iterator s21::int_set<UInt>::lower_bound(
+    const key_type &key) const {
+  UInt res = 0;
+  bool found = root_ && LowerBound(root_, kLevels - 1, key, 0, &res);
+  return iterator(this, res, !found);
+}
+
+template <typename UInt>
+typename s21::int_set<UInt>::iterator s21::int_set<UInt>::upper_bound(
+    const key_type &key) const {
+  UInt res = 0;
+  bool found = Successor(key, &res);
+  return iterator(this, res, !found);
+}
+
+template <typename UInt>
+typename s21::int_set<UInt>::Node *s21::int_set<UInt>::AddChild(
+    Node *node, unsigned digit) {
+  unsigned cnt = std::popcount(node->bits_);
+  unsigned rank = Rank(node, digit);
+
+  if (cnt == node->cap_) {
+    uint32_t cap = node->cap_ ? node->cap_ * 2 : 2;
+    Node **grown = new Node *[cap];
+    for (unsigned i = 0; i < cnt; ++i) {
+      grown[i] = node->child_[i];
+    }
+    delete[] node->child_;
+    node->child_ = grown;
+    node->cap_ = cap;
+  }
+
+  for (unsigned i = cnt; i > rank; --i) {
+    node->child_[i] = node->child_[i - 1];
+  }
+  Node *child = new Node;
+  node->child_[rank] = child;
+  node->bits_ |= uint64_t(1) << digit;
+
+  return child;
+}
+
+template <typename UInt>
+void s21::int_set<UInt>::RemoveChild(Node *node, unsigned digit) {
+  unsigned cnt = std::popcount(node->bits_);
+  for (unsigned i = Rank(node, digit); i + 1 < cnt; ++i) {
+    node->child_[i] = node->child_[i + 1];
+  }
+  node->bits_ &= ~(uint64_t(1) << digit);
+}
+
+template <typename UInt>
+void s21::int_set<UInt>::DelNode(Node *node, int level) {
+  if (level > 0) {
+    unsigned cnt = std::popcount(node->bits_);
+    for (unsigned i = 0; i < cnt; ++i) {
+      DelNode(node->child_[i], level - 1);
+    }
+    delete[] node->child_;
+  }
+  delete node;
+}
+
+template <typename UInt>
+typename s21::int_set<UInt>::Node *s21::int_set<UInt>::CloneNode(
+    const Node *node, int level) {
+  Node *copy = new Node;
+  copy->bits_ = node->bits_;
+  if (level > 0) {
+    unsigned cnt = std::popcount(node->bits_);
+    copy->child_ = new Node *[cnt];
+    copy->cap_ = cnt;
+    for (unsigned i = 0; i < cnt; ++i) {
+      copy->child_[i] = CloneNode(node->child_[i], level - 1);
+    }
+  }
+
+  return copy;
+}
+
+template <typename UInt>
+UInt s21::int_set<UInt>::Min(const Node *node, int level, UInt base) {
+  while (level > 0) {
+    unsigned digit = std::countr_zero(node->bits_);
+    base |= static_cast<UInt>(digit) << (6 * level);
+    node = node->child_[0];
+    --level;
+  }
+
+  return base | static_cast<UInt>(std::countr_zero(node->bits_));
+}
+
+template <typename UInt>
+UInt s21::int_set<UInt>::Max(const Node *node, int level, UInt base) {
+  while (level > 0) {
+    unsigned digit = 63 - std::countl_zero(node->bits_);
+    base |= static_cast<UInt>(digit) << (6 * level);
+    node = node->child_[std::popcount(node->bits_) - 1];
+    --level;
+  }
+
+  return base | static_cast<UInt>(63 - std::countl_zero(node->bits_));
+}
+
+template <typename UInt>
+bool s21::int_set<UInt>::LowerBound(const Node *node, int level, UInt key,
+                                    UInt base, UInt *res) {
+  unsigned digit = Digit(key, level);
+  bool found = false;
+
+  if (level == 0) {
+    uint64_t rest = node->bits_ & ~Below(digit);
+    if (rest) {
+      *res = base | static_cast<UInt>(std::countr_zero(rest));
+      found = true;
+    }
+  } else {
+    if ((node->bits_ >> digit) & 1) {
+      found = LowerBound(Child(node, digit), level - 1, key,
+                         base | static_cast<UInt>(digit) << (6 * level), res);
+    }
+    uint64_t rest = node->bits_ & Above(digit);
+    if (!found && rest) {
+      unsigned next = std::countr_zero(rest);
+      *res = Min(Child(node, next), level - 1,
+                 base | static_cast<UInt>(next) << (6 * level));
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+template <typename UInt>
+bool s21::int_set<UInt>::Floor(const Node *node, int level, UInt key,
+                               UInt base, UInt *res) {
+  unsigned digit = Digit(key, level);
+  bool found = false;
+
+  if (level == 0) {
+    uint64_t rest = node->bits_ & (Below(digit) | uint64_t(1) << digit);
+    if (rest) {
+      *res = base | static_cast<UInt>(63 - std::countl_zero(rest));
+      found = true;
+    }
+  } else {
+    if ((node->bits_ >> digit) & 1) {
+      found = Floor(Child(node, digit), level - 1, key,
+                    base | static_cast<UInt>(digit) << (6 * level), res);
+    }
+    uint64_t rest = node->bits_ & Below(digit);
+    if (!found && rest) {
+      unsigned prev = 63 - std::countl_zero(rest);
+      *res = Max(Child(node, prev), level - 1,
+                 base | static_cast<UInt>(prev) << (6 * level));
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+template <typename UInt>
+bool s21::int_set<UInt>::Successor(UInt key, UInt *res) const {
+  return root_ && key != std::numeric_limits<UInt>::max() &&
+         LowerBound(root_, kLevels - 1, key + 1, 0, res);
+}
+
+template <typename UInt>
+bool s21::int_set<UInt>::Predecessor(UInt key, bool inclusive,
+                                     UInt *res) const {
+  bool found = false;
+  if (root_ && (inclusive || key != 0)) {
+    found = Floor(root_, kLevels - 1, inclusive ? key : key - 1, 0, res);
+  }
+  return found;
+}
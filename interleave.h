@@ -0,0 +1,89 @@
+#ifndef INTERLEAVE_H
+#define INTERLEAVE_H
+
+#include <coroutine>
+#include <exception>
+#include <span>
+#include <utility>
+
+namespace s21 {
+// Coroutine for a chain of dependent loads, such as a descent of a tree.
+// Before it touches the next address the chain prefetches it and suspends
+// (co_await PrefetchAndYield(p)), and Interleave runs other chains
+// meanwhile, so the misses of several chains overlap instead of being paid
+// one after another. A task starts suspended and is destroyed with its
+// owner.
+class InterleavedTask {
+ public:
+  struct promise_type {
+    InterleavedTask get_return_object() {
+      return InterleavedTask(Handle::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { exception_ = std::current_exception(); }
+
+    std::exception_ptr exception_;
+  };
+  using Handle = std::coroutine_handle<promise_type>;
+
+  InterleavedTask() = default;
+  InterleavedTask(const InterleavedTask &) = delete;
+  InterleavedTask(InterleavedTask &&other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  ~InterleavedTask() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  InterleavedTask &operator=(const InterleavedTask &) = delete;
+  InterleavedTask &operator=(InterleavedTask &&other) noexcept {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  bool Done() const { return !handle_ || handle_.done(); }
+
+  // runs the task to its next suspension, rethrowing what escaped it
+  void Resume() {
+    handle_.resume();
+    if (handle_.promise().exception_) {
+      std::rethrow_exception(handle_.promise().exception_);
+    }
+  }
+
+ private:
+  explicit InterleavedTask(Handle handle) : handle_(handle) {}
+
+  Handle handle_;
+};
+
+// the suspension point of a chain, p is the address it reads next
+inline std::suspend_always PrefetchAndYield(const void *p) {
+  __builtin_prefetch(p);
+  return {};
+}
+
+// resumes the tasks round-robin until every one of them has finished
+inline void Interleave(std::span<InterleavedTask> tasks) {
+  bool live = true;
+  while (live) {
+    live = false;
+    for (InterleavedTask &task : tasks) {
+      if (!task.Done()) {
+        task.Resume();
+        live = live || !task.Done();
+      }
+    }
+  }
+}
+}  // namespace s21
+
+#endif
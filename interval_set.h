@@ -0,0 +1,133 @@
+#ifndef INTERVAL_SET_H
+#define INTERVAL_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "rbtree.h"
+
+namespace s21 {
+template <typename T>
+struct IntervalKeyOfValue {
+  const std::pair<T, T> &operator()(const std::pair<T, T> &k) const {
+    return k;
+  }
+};
+
+// keeps the largest end of the intervals in a subtree
+template <typename T>
+struct IntervalMaxEnd {
+  using value_type = T;
+  static constexpr bool kEnabled = true;
+
+  template <typename Node>
+  static void Update(Node *node) {
+    T max_end = node->data_.second;
+    if (node->left_ && max_end < node->left_->aug_) {
+      max_end = node->left_->aug_;
+    }
+    if (node->right_ && max_end < node->right_->aug_) {
+      max_end = node->right_->aug_;
+    }
+    node->aug_ = max_end;
+  }
+};
+
+// Set of half-open intervals [first, second) ordered by start, then end.
+// Every node stores the maximal end of its subtree, so overlap queries skip
+// the subtrees that end before the query and the ones that start after it.
+template <typename T>
+class interval_set
+    : private RBTree<std::pair<T, T>, std::pair<T, T>, IntervalKeyOfValue<T>,
+                     std::less<std::pair<T, T>>, IntervalMaxEnd<T>> {
+ public:
+  using BinaryTree =
+      RBTree<std::pair<T, T>, std::pair<T, T>, IntervalKeyOfValue<T>,
+             std::less<std::pair<T, T>>, IntervalMaxEnd<T>>;
+  using Node = typename BinaryTree::Node;
+
+  using point_type = T;
+  using key_type = std::pair<T, T>;
+  using value_type = key_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator =
+      typename BinaryTree::template Iterator<const value_type *,
+                                             const_reference>;
+  using const_iterator = iterator;
+  using size_type = size_t;
+
+  interval_set() = default;
+  interval_set(std::initializer_list<value_type> const &items);
+  interval_set(const interval_set &s) = default;
+  interval_set(interval_set &&s) = default;
+  ~interval_set() = default;
+  interval_set &operator=(const interval_set &s) = default;
+  interval_set &operator=(interval_set &&s) = default;
+
+  iterator begin() const {
+    return this->GetRoot() ? iterator(this->FindMinimum(), this)
+                           : iterator(nullptr);
+  }
+  iterator end() const { return iterator(nullptr, this); }
+
+  bool empty() const { return this->root_ == nullptr; }
+  size_type size() const { return this->CntElements(); }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  void clear();
+  // empty intervals (start >= end) are not stored
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(const T &start, const T &end) {
+    return insert(value_type(start, end));
+  }
+  void erase(iterator pos) { this->DelNode(pos.node_); }
+  size_type erase(const value_type &value);
+
+  iterator find(const value_type &value) const {
+    return iterator(this->Search(value), this);
+  }
+  bool contains(const value_type &value) const {
+    return this->Search(value) != nullptr;
+  }
+
+  // intervals containing point, in order, O(log n) when nothing matches
+  template <typename OutputIt>
+  OutputIt overlaps(const T &point, OutputIt out) const;
+  // intervals intersecting [start, end)
+  template <typename OutputIt>
+  OutputIt overlaps(const value_type &range, OutputIt out) const;
+
+  std::vector<value_type> overlaps(const T &point) const {
+    std::vector<value_type> res;
+    overlaps(point, std::back_inserter(res));
+    return res;
+  }
+  std::vector<value_type> overlaps(const value_type &range) const {
+    std::vector<value_type> res;
+    overlaps(range, std::back_inserter(res));
+    return res;
+  }
+  bool overlaps_any(const value_type &range) const;
+
+  TreeShape inspect() const { return this->Inspect(); }
+  bool validate() const { return this->Validate(true); }
+
+ private:
+  template <typename Match, typename GoRight, typename OutputIt>
+  static void CollectOverlaps(const Node *node, const T &lo,
+                              const Match &match, const GoRight &go_right,
+                              OutputIt &out);
+};
+}  // namespace s21
+
+#include "interval_set.tpp"
+
+#endif
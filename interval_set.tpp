@@ -0,0 +1,111 @@
+#include "interval_set.h"
+
+template <typename T>
+s21::interval_set<T>::interval_set(
+    std::initializer_list<value_type> const &items) {
+  for (const auto &elem : items) {
+    insert(elem);
+  }
+}
+
+template <typename T>
+void s21::interval_set<T>::clear() {
+  this->DelTree(this->root_);
+  this->root_ = nullptr;
+}
+
+template <typename T>
+std::pair<typename s21::interval_set<T>::iterator, bool>
+s21::interval_set<T>::insert(const value_type &value) {
+  std::pair<iterator, bool> res(end(), false);
+
+  if (value.first < value.second) {
+    auto pos = this->FindUniquePos(value);
+    if (pos.found_) {
+      res.first = iterator(pos.found_, this);
+    } else {
+      Node *node = this->CreateNode(value);
+      this->LinkNode(node, pos);
+      res.first = iterator(node, this);
+      res.second = true;
+    }
+  }
+
+  return res;
+}
+
+template <typename T>
+typename s21::interval_set<T>::size_type s21::interval_set<T>::erase(
+    const value_type &value) {
+  Node *node = this->Search(value);
+  this->DelNode(node);
+  return node ? 1 : 0;
+}
+
+template <typename T>
+template <typename OutputIt>
+OutputIt s21::interval_set<T>::overlaps(const T &point, OutputIt out) const {
+  CollectOverlaps(
+      this->root_, point,
+      [&point](const value_type &v) {
+        return !(point < v.first) && point < v.second;
+      },
+      [&point](const value_type &v) { return !(point < v.first); }, out);
+  return out;
+}
+
+template <typename T>
+template <typename OutputIt>
+OutputIt s21::interval_set<T>::overlaps(const value_type &range,
+                                        OutputIt out) const {
+  if (range.first < range.second) {
+    CollectOverlaps(
+        this->root_, range.first,
+        [&range](const value_type &v) {
+          return v.first < range.second && range.first < v.second;
+        },
+        [&range](const value_type &v) { return v.first < range.second; },
+        out);
+  }
+  return out;
+}
+
+template <typename T>
+bool s21::interval_set<T>::overlaps_any(const value_type &range) const {
+  bool res = false;
+  const Node *cur = range.first < range.second ? this->root_ : nullptr;
+
+  // the classic interval tree descent: go left whenever the left subtree
+  // still reaches past the start of the range
+  while (cur && !res) {
+    if (cur->data_.first < range.second && range.first < cur->data_.second) {
+      res = true;
+    } else if (cur->left_ && range.first < cur->left_->aug_) {
+      cur = cur->left_;
+    } else {
+      cur = cur->right_;
+    }
+  }
+
+  return res;
+}
+
+// in-order walk that prunes subtrees whose maximal end is not past lo and
+// right subtrees that start after the query
+template <typename T>
+template <typename Match, typename GoRight, typename OutputIt>
+void s21::interval_set<T>::CollectOverlaps(const Node *node, const T &lo,
+                                           const Match &match,
+                                           const GoRight &go_right,
+                                           OutputIt &out) {
+  if (node && lo < node->aug_) {
+    CollectOverlaps(node->left_, lo, match, go_right, out);
+    if (match(node->data_)) {
+      *out = node->data_;
+      ++out;
+    }
+    if (go_right(node->data_)) {
+      CollectOverlaps(node->right_, lo, match, go_right, out);
+    }
+  }
+}
@@ -0,0 +1,218 @@
+#ifndef LIST_H
+#define LIST_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "node_pool.h"
+
+namespace s21 {
+struct ListNodeBase {
+  ListNodeBase *prev_;
+  ListNodeBase *next_;
+};
+
+template <typename T>
+struct ListNode : ListNodeBase {
+  template <typename... Args>
+  explicit ListNode(Args &&...args) : value_(std::forward<Args>(args)...) {}
+
+  T value_;
+};
+
+// Doubly linked list whose nodes come from a NodePool. splice and merge
+// only relink nodes, so they allocate no nodes and iterators to the moved
+// elements stay valid, whatever pools the two lists use. Nodes keep their
+// pool: a list that receives nodes from another pool shares ownership of
+// it and gives each node back to the pool holding its slot, at a cost of
+// O(log blocks) per pool when the node is freed. Lists that share one pool
+// (see the pool constructor) skip that lookup. An empty list without a pool
+// adopts the pool of the nodes it receives. sort is a bottom-up merge sort
+// that only relinks nodes. Lists that exchanged nodes share pools, so like
+// lists on one pool they must stay on one thread.
+template <typename T>
+class list {
+ public:
+  using Node = ListNode<T>;
+  using pool_type = NodePool<Node>;
+
+  template <typename Pointer, typename Reference>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Pointer;
+    using reference = Reference;
+
+    ListNodeBase *node_ = nullptr;
+
+    Iterator() = default;
+    explicit Iterator(ListNodeBase *node) : node_(node) {}
+    // iterator converts to const_iterator
+    template <typename P, typename R>
+      requires std::is_convertible_v<P, Pointer>
+    Iterator(const Iterator<P, R> &other) : node_(other.node_) {}
+
+    Reference operator*() const { return static_cast<Node *>(node_)->value_; }
+    Pointer operator->() const { return &**this; }
+
+    Iterator &operator++() {
+      node_ = node_->next_;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator res = *this;
+      node_ = node_->next_;
+      return res;
+    }
+    Iterator &operator--() {
+      node_ = node_->prev_;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator res = *this;
+      node_ = node_->prev_;
+      return res;
+    }
+
+    template <typename P, typename R>
+    bool operator==(const Iterator<P, R> &other) const {
+      return node_ == other.node_;
+    }
+  };
+
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = Iterator<T *, T &>;
+  using const_iterator = Iterator<const T *, const T &>;
+  using size_type = size_t;
+
+  list() { Reset(); }
+  // the list allocates from pool, other lists on the same pool splice in O(1)
+  explicit list(std::shared_ptr<pool_type> pool) : pool_(std::move(pool)) {
+    Reset();
+  }
+  explicit list(size_type n);
+  list(std::initializer_list<value_type> const &items);
+  list(const list &l);
+  list(list &&l) noexcept;
+  ~list();
+
+  list &operator=(const list &l);
+  list &operator=(list &&l) noexcept;
+
+  const std::shared_ptr<pool_type> &pool() const { return pool_; }
+
+  reference front() { return *begin(); }
+  const_reference front() const { return *begin(); }
+  reference back() { return *--end(); }
+  const_reference back() const { return *--end(); }
+
+  iterator begin() { return iterator(head_.next_); }
+  iterator end() { return iterator(&head_); }
+  const_iterator begin() const { return const_iterator(head_.next_); }
+  const_iterator end() const {
+    return const_iterator(const_cast<ListNodeBase *>(&head_));
+  }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  void clear();
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+  }
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(end(), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    return *emplace(begin(), std::forward<Args>(args)...);
+  }
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  void push_front(const_reference value) { emplace_front(value); }
+  void push_front(T &&value) { emplace_front(std::move(value)); }
+  void pop_back() { erase(--end()); }
+  void pop_front() { erase(begin()); }
+  void swap(list &other) noexcept;
+
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args);
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    (emplace_back(std::forward<Args>(args)), ...);
+  }
+  template <typename... Args>
+  void insert_many_front(Args &&...args) {
+    insert_many(begin(), std::forward<Args>(args)...);
+  }
+
+  // moves the nodes of other (all, one, or [first, last)) before pos
+  void splice(const_iterator pos, list &other);
+  void splice(const_iterator pos, list &other, const_iterator it);
+  void splice(const_iterator pos, list &other, const_iterator first,
+              const_iterator last);
+
+  // merges the sorted other into this sorted list, stable
+  void merge(list &other) { merge(other, std::less<T>()); }
+  template <typename Compare>
+  void merge(list &other, Compare comp);
+  void sort() { sort(std::less<T>()); }
+  // stable, O(n log n) comparisons, allocates nothing
+  template <typename Compare>
+  void sort(Compare comp);
+  void reverse();
+  // drops each element equal to the one before it
+  size_type unique();
+
+ private:
+  void Reset() { head_.prev_ = head_.next_ = &head_; }
+  template <typename... Args>
+  Node *CreateNode(Args &&...args);
+  void DestroyNode(ListNodeBase *node);
+  // takes on the pools of other's nodes, before nodes of other move here
+  void SharePools(const list &other);
+  // the pool whose slot node is
+  pool_type *PoolOf(ListNodeBase *node) const;
+  // unlinks [first, last) and links it before pos, sizes are left alone
+  static void Transfer(ListNodeBase *pos, ListNodeBase *first,
+                       ListNodeBase *last);
+  // merges two sorted null-terminated chains, a wins ties
+  template <typename Compare>
+  static ListNodeBase *MergeRuns(ListNodeBase *a, ListNodeBase *b,
+                                 Compare &comp);
+  // takes the nodes and the pool of other, which is left empty
+  void Steal(list &other);
+
+  ListNodeBase head_;
+  size_type size_ = 0;
+  // new nodes come from pool_, nodes spliced in may also be from these
+  std::shared_ptr<pool_type> pool_;
+  std::vector<std::shared_ptr<pool_type>> foreign_;
+};
+}  // namespace s21
+
+#include "list.tpp"
+
+#endif
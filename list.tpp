@@ -0,0 +1,362 @@
+#include <algorithm>
+#include <new>
+
+#include "list.h"
+
+template <typename T>
+s21::list<T>::list(size_type n) {
+  Reset();
+  for (size_type i = 0; i < n; ++i) {
+    emplace_back();
+  }
+}
+
+template <typename T>
+s21::list<T>::list(std::initializer_list<value_type> const &items) {
+  Reset();
+  for (const auto &item : items) {
+    push_back(item);
+  }
+}
+
+template <typename T>
+s21::list<T>::list(const list &l) {
+  Reset();
+  for (const auto &item : l) {
+    push_back(item);
+  }
+}
+
+template <typename T>
+s21::list<T>::list(list &&l) noexcept {
+  Reset();
+  Steal(l);
+}
+
+template <typename T>
+s21::list<T>::~list() {
+  clear();
+}
+
+template <typename T>
+s21::list<T> &s21::list<T>::operator=(const list &l) {
+  if (this != &l) {
+    clear();
+    for (const auto &item : l) {
+      push_back(item);
+    }
+  }
+  return *this;
+}
+
+template <typename T>
+s21::list<T> &s21::list<T>::operator=(list &&l) noexcept {
+  if (this != &l) {
+    clear();
+    Steal(l);
+  }
+  return *this;
+}
+
+template <typename T>
+void s21::list<T>::clear() {
+  ListNodeBase *node = head_.next_;
+  while (node != &head_) {
+    ListNodeBase *next = node->next_;
+    DestroyNode(node);
+    node = next;
+  }
+  Reset();
+  size_ = 0;
+  foreign_.clear();
+}
+
+template <typename T>
+template <typename... Args>
+typename s21::list<T>::iterator s21::list<T>::emplace(const_iterator pos,
+                                                      Args &&...args) {
+  Node *node = CreateNode(std::forward<Args>(args)...);
+  ListNodeBase *next = pos.node_;
+  node->next_ = next;
+  node->prev_ = next->prev_;
+  next->prev_->next_ = node;
+  next->prev_ = node;
+  ++size_;
+
+  return iterator(node);
+}
+
+template <typename T>
+typename s21::list<T>::iterator s21::list<T>::erase(const_iterator pos) {
+  ListNodeBase *node = pos.node_;
+  ListNodeBase *next = node->next_;
+  node->prev_->next_ = next;
+  next->prev_ = node->prev_;
+  DestroyNode(node);
+  --size_;
+
+  return iterator(next);
+}
+
+template <typename T>
+typename s21::list<T>::iterator s21::list<T>::erase(const_iterator first,
+                                                    const_iterator last) {
+  while (first != last) {
+    first = erase(first);
+  }
+  return iterator(last.node_);
+}
+
+template <typename T>
+void s21::list<T>::swap(list &other) noexcept {
+  if (this != &other) {
+    list tmp(std::move(other));
+    other.Steal(*this);
+    Steal(tmp);
+  }
+}
+
+template <typename T>
+template <typename... Args>
+typename s21::list<T>::iterator s21::list<T>::insert_many(const_iterator pos,
+                                                          Args &&...args) {
+  ListNodeBase *before = pos.node_->prev_;
+  (emplace(pos, std::forward<Args>(args)), ...);
+  return iterator(before->next_);
+}
+
+template <typename T>
+void s21::list<T>::splice(const_iterator pos, list &other) {
+  if (this != &other && !other.empty()) {
+    SharePools(other);
+    Transfer(pos.node_, other.head_.next_, &other.head_);
+    size_ += other.size_;
+    other.size_ = 0;
+  }
+}
+
+template <typename T>
+void s21::list<T>::splice(const_iterator pos, list &other, const_iterator it) {
+  ListNodeBase *node = it.node_;
+  if (pos.node_ != node && pos.node_ != node->next_) {
+    if (this != &other) {
+      SharePools(other);
+    }
+    Transfer(pos.node_, node, node->next_);
+    if (this != &other) {
+      ++size_;
+      --other.size_;
+    }
+  }
+}
+
+template <typename T>
+void s21::list<T>::splice(const_iterator pos, list &other,
+                          const_iterator first, const_iterator last) {
+  if (first != last) {
+    size_type n = 0;
+    if (this != &other) {
+      n = std::distance(first, last);
+      SharePools(other);
+    }
+    Transfer(pos.node_, first.node_, last.node_);
+    size_ += n;
+    other.size_ -= n;
+  }
+}
+
+template <typename T>
+template <typename Compare>
+void s21::list<T>::merge(list &other, Compare comp) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  SharePools(other);
+  ListNodeBase *from = other.head_.next_;
+  ListNodeBase *to = head_.next_;
+  while (from != &other.head_ && to != &head_) {
+    if (comp(static_cast<Node *>(from)->value_,
+             static_cast<Node *>(to)->value_)) {
+      ListNodeBase *next = from->next_;
+      Transfer(to, from, next);
+      from = next;
+    } else {
+      to = to->next_;
+    }
+  }
+  Transfer(&head_, from, &other.head_);
+  size_ += other.size_;
+  other.size_ = 0;
+}
+
+// Runs of 2^i nodes wait in bins[i] and are merged like a binary counter
+// is incremented, so the list is never walked to find a middle.
+template <typename T>
+template <typename Compare>
+void s21::list<T>::sort(Compare comp) {
+  if (size_ < 2) {
+    return;
+  }
+  head_.prev_->next_ = nullptr;
+  ListNodeBase *chain = head_.next_;
+  ListNodeBase *bins[64] = {};
+  while (chain) {
+    ListNodeBase *run = chain;
+    chain = chain->next_;
+    run->next_ = nullptr;
+    size_t i = 0;
+    for (; bins[i]; ++i) {
+      run = MergeRuns(bins[i], run, comp);
+      bins[i] = nullptr;
+    }
+    bins[i] = run;
+  }
+  ListNodeBase *res = nullptr;
+  for (ListNodeBase *bin : bins) {
+    if (bin) {
+      res = res ? MergeRuns(bin, res, comp) : bin;
+    }
+  }
+
+  ListNodeBase *prev = &head_;
+  for (ListNodeBase *node = res; node; node = node->next_) {
+    node->prev_ = prev;
+    prev->next_ = node;
+    prev = node;
+  }
+  prev->next_ = &head_;
+  head_.prev_ = prev;
+}
+
+template <typename T>
+void s21::list<T>::reverse() {
+  ListNodeBase *node = &head_;
+  do {
+    std::swap(node->prev_, node->next_);
+    node = node->prev_;
+  } while (node != &head_);
+}
+
+template <typename T>
+typename s21::list<T>::size_type s21::list<T>::unique() {
+  size_type removed = 0;
+  if (!empty()) {
+    iterator prev = begin();
+    for (iterator it = std::next(prev); it != end();) {
+      if (*it == *prev) {
+        it = erase(it);
+        ++removed;
+      } else {
+        prev = it++;
+      }
+    }
+  }
+  return removed;
+}
+
+template <typename T>
+template <typename... Args>
+typename s21::list<T>::Node *s21::list<T>::CreateNode(Args &&...args) {
+  if (!pool_) {
+    pool_ = std::make_shared<pool_type>();
+  }
+  void *p = pool_->Allocate();
+  try {
+    return ::new (p) Node(std::forward<Args>(args)...);
+  } catch (...) {
+    pool_->Deallocate(p);
+    throw;
+  }
+}
+
+template <typename T>
+void s21::list<T>::DestroyNode(ListNodeBase *node) {
+  pool_type *pool = PoolOf(node);
+  Node *n = static_cast<Node *>(node);
+  n->~Node();
+  pool->Deallocate(n);
+}
+
+template <typename T>
+void s21::list<T>::SharePools(const list &other) {
+  if (!pool_) {
+    pool_ = other.pool_;
+  }
+  auto share = [this](const std::shared_ptr<pool_type> &pool) {
+    if (pool && pool != pool_ &&
+        std::find(foreign_.begin(), foreign_.end(), pool) == foreign_.end()) {
+      foreign_.push_back(pool);
+    }
+  };
+  share(other.pool_);
+  for (const auto &pool : other.foreign_) {
+    share(pool);
+  }
+}
+
+template <typename T>
+typename s21::list<T>::pool_type *s21::list<T>::PoolOf(
+    ListNodeBase *node) const {
+  if (foreign_.empty() || pool_->Owns(node)) {
+    return pool_.get();
+  }
+  for (const auto &pool : foreign_) {
+    if (pool->Owns(node)) {
+      return pool.get();
+    }
+  }
+  return pool_.get();
+}
+
+template <typename T>
+void s21::list<T>::Transfer(ListNodeBase *pos, ListNodeBase *first,
+                            ListNodeBase *last) {
+  if (first == last) {
+    return;
+  }
+  ListNodeBase *back = last->prev_;
+  first->prev_->next_ = last;
+  last->prev_ = first->prev_;
+
+  ListNodeBase *before = pos->prev_;
+  before->next_ = first;
+  first->prev_ = before;
+  back->next_ = pos;
+  pos->prev_ = back;
+}
+
+template <typename T>
+template <typename Compare>
+s21::ListNodeBase *s21::list<T>::MergeRuns(ListNodeBase *a, ListNodeBase *b,
+                                           Compare &comp) {
+  ListNodeBase head;
+  ListNodeBase *tail = &head;
+  while (a && b) {
+    if (comp(static_cast<Node *>(b)->value_, static_cast<Node *>(a)->value_)) {
+      tail->next_ = b;
+      b = b->next_;
+    } else {
+      tail->next_ = a;
+      a = a->next_;
+    }
+    tail = tail->next_;
+  }
+  tail->next_ = a ? a : b;
+
+  return head.next_;
+}
+
+template <typename T>
+void s21::list<T>::Steal(list &other) {
+  pool_ = std::move(other.pool_);
+  foreign_ = std::move(other.foreign_);
+  other.foreign_.clear();
+  if (!other.empty()) {
+    head_ = other.head_;
+    head_.next_->prev_ = &head_;
+    head_.prev_->next_ = &head_;
+    size_ = other.size_;
+    other.Reset();
+    other.size_ = 0;
+  }
+}
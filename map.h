@@ -0,0 +1,230 @@
+#ifndef MAP_H
+#define MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "rbtree.h"
+#include "vector.h"
+
+namespace s21 {
+template <typename Key, typename T>
+struct MapKeyOfValue {
+  const Key &operator()(const std::pair<const Key, T> &v) const {
+    return v.first;
+  }
+};
+
+// Ordered map on RBTree. Every insertion finds its slot with one descent
+// and builds the value in the node, so try_emplace, insert_or_assign and
+// operator[] neither copy the mapped value nor allocate when the key exists.
+// With a transparent Compare lookups accept any key comparable to Key.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class map : private RBTree<std::pair<const Key, T>, Key, MapKeyOfValue<Key, T>,
+                           Compare> {
+ public:
+  using BinaryTree =
+      RBTree<std::pair<const Key, T>, Key, MapKeyOfValue<Key, T>, Compare>;
+  using Node = typename BinaryTree::Node;
+
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator =
+      typename BinaryTree::template Iterator<value_type *, reference>;
+  using const_iterator =
+      typename BinaryTree::template Iterator<const value_type *,
+                                             const_reference>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using node_type = NodeHandle<value_type>;
+
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
+  map() = default;
+  map(std::initializer_list<value_type> const &items);
+  map(const map &m) = default;
+  map(map &&m) = default;
+  ~map() = default;
+  map &operator=(const map &m) = default;
+  map &operator=(map &&m) = default;
+
+  // throws std::out_of_range when there is no such key
+  T &at(const Key &key);
+  const T &at(const Key &key) const;
+  T &operator[](const Key &key) { return try_emplace(key).first->second; }
+  T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // the const overloads only read the tree, so concurrent readers may share
+  // one instance as long as nobody modifies it, see set
+  iterator begin() {
+    return this->GetRoot() ? iterator(this->FindMinimum(), this)
+                           : iterator(nullptr);
+  }
+  const_iterator begin() const {
+    return const_iterator(this->FindMinimum(), this);
+  }
+  iterator end() { return iterator(nullptr, this); }
+  const_iterator end() const { return const_iterator(nullptr, this); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+
+  bool empty() const { return this->root_ == nullptr; }
+  size_type size() const { return this->CntElements(); }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  void clear();
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(const Key &key, const T &obj) {
+    return try_emplace(key, obj);
+  }
+  insert_return_type insert(node_type &&nh);
+  // when the key belongs right before hint it is linked there after two
+  // key comparisons instead of a descent's log n; finding the node before
+  // hint still walks O(log n) links, for end() the right spine
+  iterator insert(iterator hint, const value_type &value);
+  template <typename... Args>
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    return InsertOrAssign(key, std::forward<M>(obj));
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&obj) {
+    return InsertOrAssign(std::move(key), std::forward<M>(obj));
+  }
+
+  // the mapped value is built from args only when key is missing
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    return TryEmplace(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key &&key, Args &&...args) {
+    return TryEmplace(std::move(key), std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  iterator try_emplace(iterator hint, const Key &key, Args &&...args);
+
+  // builds the node before the descent, as the key is only known then
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args);
+
+  void erase(iterator pos) { this->DelNode(pos.node_); }
+  size_type erase(const Key &key);
+  node_type extract(iterator pos) {
+    return node_type(this->ExtractNode(pos.node_));
+  }
+  node_type extract(const Key &key) {
+    return node_type(this->ExtractNode(this->Search(key)));
+  }
+  void swap(map &other);
+  void merge(map &other);
+
+  iterator find(const Key &key) { return iterator(this->Search(key), this); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(this->Search(key), this);
+  }
+  bool contains(const Key &key) const {
+    return this->Search(key) != nullptr;
+  }
+  size_type count(const Key &key) const { return contains(key); }
+  iterator lower_bound(const Key &key) {
+    return iterator(this->LowerBound(key), this);
+  }
+  const_iterator lower_bound(const Key &key) const {
+    return const_iterator(this->LowerBound(key), this);
+  }
+  iterator upper_bound(const Key &key) {
+    return iterator(this->UpperBound(key), this);
+  }
+  const_iterator upper_bound(const Key &key) const {
+    return const_iterator(this->UpperBound(key), this);
+  }
+
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  iterator find(const K &key) {
+    return iterator(FindTransparent(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  const_iterator find(const K &key) const {
+    return const_iterator(FindTransparent(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  bool contains(const K &key) const;
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  iterator lower_bound(const K &key) {
+    return iterator(this->LowerBound(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  iterator upper_bound(const K &key) {
+    return iterator(this->UpperBound(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  const_iterator lower_bound(const K &key) const {
+    return const_iterator(this->LowerBound(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  const_iterator upper_bound(const K &key) const {
+    return const_iterator(this->UpperBound(key), this);
+  }
+
+  // all zero unless built with S21_RBTREE_STATS
+  TreeStats stats() const { return this->GetStats(); }
+  void reset_stats() { this->ResetStats(); }
+
+  TreeShape inspect() const { return this->Inspect(); }
+  bool validate() const { return this->Validate(true); }
+
+ private:
+  template <typename K>
+  Node *FindTransparent(const K &key) const;
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> TryEmplace(K &&key, Args &&...args);
+  template <typename K, typename M>
+  std::pair<iterator, bool> InsertOrAssign(K &&key, M &&obj);
+};
+}  // namespace s21
+
+#include "map.tpp"
+
+#endif
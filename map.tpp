@@ -0,0 +1,209 @@
+#include <stdexcept>
+
+#include "map.h"
+
+template <typename Key, typename T, typename Compare>
+s21::map<Key, T, Compare>::map(
+    std::initializer_list<value_type> const &items) {
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename T, typename Compare>
+T &s21::map<Key, T, Compare>::at(const Key &key) {
+  Node *node = this->Search(key);
+  if (!node) {
+    throw std::out_of_range("map::at: no such key");
+  }
+  return node->data_.second;
+}
+
+template <typename Key, typename T, typename Compare>
+const T &s21::map<Key, T, Compare>::at(const Key &key) const {
+  Node *node = this->Search(key);
+  if (!node) {
+    throw std::out_of_range("map::at: no such key");
+  }
+  return node->data_.second;
+}
+
+template <typename Key, typename T, typename Compare>
+void s21::map<Key, T, Compare>::clear() {
+  this->DelTree(this->root_);
+  this->root_ = nullptr;
+}
+
+template <typename Key, typename T, typename Compare>
+std::pair<typename s21::map<Key, T, Compare>::iterator, bool>
+s21::map<Key, T, Compare>::insert(const value_type &value) {
+  auto pos = this->FindUniquePos(value.first);
+  if (pos.found_) {
+    return std::make_pair(iterator(pos.found_, this), false);
+  }
+  Node *node = this->CreateNode(value);
+  this->LinkNode(node, pos);
+  return std::make_pair(iterator(node, this), true);
+}
+
+template <typename Key, typename T, typename Compare>
+typename s21::map<Key, T, Compare>::insert_return_type
+s21::map<Key, T, Compare>::insert(node_type &&nh) {
+  insert_return_type res{end(), false, node_type()};
+
+  if (!nh.empty()) {
+    auto pos = this->FindUniquePos(nh.value().first);
+    if (pos.found_) {
+      res.position = iterator(pos.found_, this);
+      res.node = std::move(nh);
+    } else {
+      Node *node = nh.Release();
+      this->LinkNode(node, pos);
+      res.position = iterator(node, this);
+      res.inserted = true;
+    }
+  }
+
+  return res;
+}
+
+template <typename Key, typename T, typename Compare>
+typename s21::map<Key, T, Compare>::iterator s21::map<Key, T, Compare>::insert(
+    iterator hint, const value_type &value) {
+  auto pos = this->FindHintUniquePos(hint.node_, value.first);
+  if (pos.found_) {
+    return iterator(pos.found_, this);
+  }
+  Node *node = this->CreateNode(value);
+  this->LinkNode(node, pos);
+  return iterator(node, this);
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+s21::vector<std::pair<typename s21::map<Key, T, Compare>::iterator, bool>,
+            sizeof...(Args)>
+s21::map<Key, T, Compare>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
+  (results.push_back(insert(value_type(std::forward<Args>(args)))), ...);
+  return results;
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+typename s21::map<Key, T, Compare>::iterator
+s21::map<Key, T, Compare>::try_emplace(iterator hint, const Key &key,
+                                       Args &&...args) {
+  auto pos = this->FindHintUniquePos(hint.node_, key);
+  if (pos.found_) {
+    return iterator(pos.found_, this);
+  }
+  Node *node = this->EmplaceNode(
+      std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+  this->LinkNode(node, pos);
+  return iterator(node, this);
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+std::pair<typename s21::map<Key, T, Compare>::iterator, bool>
+s21::map<Key, T, Compare>::emplace(Args &&...args) {
+  Node *node = this->EmplaceNode(std::forward<Args>(args)...);
+  auto res = this->InsertUniqueNode(node);
+  if (!res.second) {
+    this->DestroyNode(node);
+  }
+  return std::make_pair(iterator(res.first, this), res.second);
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+typename s21::map<Key, T, Compare>::iterator
+s21::map<Key, T, Compare>::emplace_hint(iterator hint, Args &&...args) {
+  Node *node = this->EmplaceNode(std::forward<Args>(args)...);
+  auto pos = this->FindHintUniquePos(hint.node_, node->data_.first);
+  if (pos.found_) {
+    this->DestroyNode(node);
+    return iterator(pos.found_, this);
+  }
+  this->LinkNode(node, pos);
+  return iterator(node, this);
+}
+
+template <typename Key, typename T, typename Compare>
+typename s21::map<Key, T, Compare>::size_type s21::map<Key, T, Compare>::erase(
+    const Key &key) {
+  Node *node = this->Search(key);
+  this->DelNode(node);
+  return node ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare>
+void s21::map<Key, T, Compare>::swap(map &other) {
+  std::swap(this->root_, other.root_);
+  std::swap(this->comp, other.comp);
+  std::swap(this->key_of_value, other.key_of_value);
+}
+
+template <typename Key, typename T, typename Compare>
+void s21::map<Key, T, Compare>::merge(map &other) {
+  if (this != &other) {
+    iterator it = other.begin();
+    while (it != other.end()) {
+      iterator next = it;
+      ++next;
+      // the position stays valid while the node is unlinked from other
+      auto pos = this->FindUniquePos(it->first);
+      if (!pos.found_) {
+        this->LinkNode(other.ExtractNode(it.node_), pos);
+      }
+      it = next;
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename K>
+typename s21::map<Key, T, Compare>::Node *
+s21::map<Key, T, Compare>::FindTransparent(const K &key) const {
+  Node *node = this->LowerBound(key);
+  return node && !this->Less(key, node->data_.first) ? node : nullptr;
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename K>
+  requires requires { typename Compare::is_transparent; }
+bool s21::map<Key, T, Compare>::contains(const K &key) const {
+  Node *node = this->LowerBound(key);
+  return node && !this->Less(key, node->data_.first);
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename K, typename... Args>
+std::pair<typename s21::map<Key, T, Compare>::iterator, bool>
+s21::map<Key, T, Compare>::TryEmplace(K &&key, Args &&...args) {
+  auto pos = this->FindUniquePos(key);
+  if (pos.found_) {
+    return std::make_pair(iterator(pos.found_, this), false);
+  }
+  Node *node = this->EmplaceNode(
+      std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+  this->LinkNode(node, pos);
+  return std::make_pair(iterator(node, this), true);
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename K, typename M>
+std::pair<typename s21::map<Key, T, Compare>::iterator, bool>
+s21::map<Key, T, Compare>::InsertOrAssign(K &&key, M &&obj) {
+  auto pos = this->FindUniquePos(key);
+  if (pos.found_) {
+    pos.found_->data_.second = std::forward<M>(obj);
+    return std::make_pair(iterator(pos.found_, this), false);
+  }
+  Node *node = this->EmplaceNode(std::forward<K>(key), std::forward<M>(obj));
+  this->LinkNode(node, pos);
+  return std::make_pair(iterator(node, this), true);
+}
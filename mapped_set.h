@@ -0,0 +1,73 @@
+#ifndef MAPPED_SET_H
+#define MAPPED_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "sorted_file.h"
+
+namespace s21 {
+// Read-only set over a file written by set::serialize or multiset::serialize.
+// The file is mapped as is: opening costs one mmap, lookups binary search
+// the key array in the mapping and iterators are plain pointers into it, so
+// pages are read lazily by the kernel on first access.
+template <typename Key, typename Compare = std::less<Key>>
+class mapped_set {
+  static_assert(std::is_trivially_copyable_v<Key>,
+                "sorted files store keys as raw bytes");
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const value_type &;
+  using const_iterator = const Key *;
+  using iterator = const_iterator;
+  using size_type = size_t;
+
+  // throws std::runtime_error when the file can not be mapped, has a bad
+  // header or, with verify_checksum, does not match its checksum
+  explicit mapped_set(const std::string &path, bool verify_checksum = false);
+  mapped_set(const mapped_set &) = delete;
+  mapped_set(mapped_set &&other) noexcept;
+  ~mapped_set();
+
+  mapped_set &operator=(const mapped_set &) = delete;
+  mapped_set &operator=(mapped_set &&other) noexcept;
+
+  iterator begin() const { return keys_; }
+  iterator end() const { return keys_ + count_; }
+
+  bool empty() const { return count_ == 0; }
+  size_type size() const { return count_; }
+  bool multi() const { return header_.flags_ & kSortedFileMulti; }
+
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const { return find(key) != end(); }
+  size_type count(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  // recomputes the checksum of the mapped keys, reads the whole file
+  bool verify() const;
+
+ private:
+  void Unmap();
+
+  void *map_ = nullptr;
+  size_t map_len_ = 0;
+  const Key *keys_ = nullptr;
+  size_t count_ = 0;
+  SortedFileHeader header_;
+  Compare comp_;
+};
+}  // namespace s21
+
+#include "mapped_set.tpp"
+
+#endif
@@ -0,0 +1,131 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "mapped_set.h"
+
+template <typename Key, typename Compare>
+s21::mapped_set<Key, Compare>::mapped_set(const std::string &path,
+                                          bool verify_checksum) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("mapped_set: can not open " + path);
+  }
+
+  struct stat st;
+  size_t len = 0;
+  if (::fstat(fd, &st) == 0) {
+    len = static_cast<size_t>(st.st_size);
+  }
+  void *map = len >= sizeof(SortedFileHeader)
+                  ? ::mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0)
+                  : MAP_FAILED;
+  // the mapping keeps the file alive on its own
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    throw std::runtime_error("mapped_set: can not map " + path);
+  }
+  map_ = map;
+  map_len_ = len;
+
+  try {
+    std::memcpy(&header_, map_, sizeof(header_));
+    header_.Check(sizeof(Key), alignof(Key));
+    if (header_.data_offset_ > len ||
+        header_.count_ > (len - header_.data_offset_) / sizeof(Key)) {
+      throw std::runtime_error("sorted file: truncated");
+    }
+    keys_ = reinterpret_cast<const Key *>(static_cast<const char *>(map_) +
+                                          header_.data_offset_);
+    count_ = header_.count_;
+    if (verify_checksum && !verify()) {
+      throw std::runtime_error("sorted file: checksum mismatch");
+    }
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+}
+
+template <typename Key, typename Compare>
+s21::mapped_set<Key, Compare>::mapped_set(mapped_set &&other) noexcept
+    : map_(other.map_),
+      map_len_(other.map_len_),
+      keys_(other.keys_),
+      count_(other.count_),
+      header_(other.header_),
+      comp_(std::move(other.comp_)) {
+  other.map_ = nullptr;
+  other.map_len_ = 0;
+  other.keys_ = nullptr;
+  other.count_ = 0;
+}
+
+template <typename Key, typename Compare>
+s21::mapped_set<Key, Compare>::~mapped_set() {
+  Unmap();
+}
+
+template <typename Key, typename Compare>
+s21::mapped_set<Key, Compare> &s21::mapped_set<Key, Compare>::operator=(
+    mapped_set &&other) noexcept {
+  if (this != &other) {
+    Unmap();
+    std::swap(map_, other.map_);
+    std::swap(map_len_, other.map_len_);
+    std::swap(keys_, other.keys_);
+    std::swap(count_, other.count_);
+    header_ = other.header_;
+    comp_ = std::move(other.comp_);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare>
+typename s21::mapped_set<Key, Compare>::iterator
+s21::mapped_set<Key, Compare>::find(const key_type &key) const {
+  iterator res = lower_bound(key);
+  return res != end() && !comp_(key, *res) ? res : end();
+}
+
+template <typename Key, typename Compare>
+typename s21::mapped_set<Key, Compare>::size_type
+s21::mapped_set<Key, Compare>::count(const key_type &key) const {
+  auto range = equal_range(key);
+  return range.second - range.first;
+}
+
+template <typename Key, typename Compare>
+typename s21::mapped_set<Key, Compare>::iterator
+s21::mapped_set<Key, Compare>::lower_bound(const key_type &key) const {
+  return std::lower_bound(begin(), end(), key, comp_);
+}
+
+template <typename Key, typename Compare>
+typename s21::mapped_set<Key, Compare>::iterator
+s21::mapped_set<Key, Compare>::upper_bound(const key_type &key) const {
+  return std::upper_bound(begin(), end(), key, comp_);
+}
+
+template <typename Key, typename Compare>
+bool s21::mapped_set<Key, Compare>::verify() const {
+  SortedFileChecksum checksum;
+  checksum.Update(keys_, count_ * sizeof(Key));
+  return checksum.Value() == header_.checksum_;
+}
+
+template <typename Key, typename Compare>
+void s21::mapped_set<Key, Compare>::Unmap() {
+  if (map_) {
+    ::munmap(map_, map_len_);
+  }
+  map_ = nullptr;
+  map_len_ = 0;
+  keys_ = nullptr;
+  count_ = 0;
+}
@@ -0,0 +1,186 @@
+#ifndef MULTIMAP_H
+#define MULTIMAP_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "map.h"
+#include "rbtree.h"
+#include "vector.h"
+
+namespace s21 {
+// Ordered map with equal keys kept in insertion order, on the same tree and
+// in-place construction as map.
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class multimap : private RBTree<std::pair<const Key, T>, Key,
+                                MapKeyOfValue<Key, T>, Compare> {
+ public:
+  using BinaryTree =
+      RBTree<std::pair<const Key, T>, Key, MapKeyOfValue<Key, T>, Compare>;
+  using Node = typename BinaryTree::Node;
+
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator =
+      typename BinaryTree::template Iterator<value_type *, reference>;
+  using const_iterator =
+      typename BinaryTree::template Iterator<const value_type *,
+                                             const_reference>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using node_type = NodeHandle<value_type>;
+
+  multimap() = default;
+  multimap(std::initializer_list<value_type> const &items);
+  multimap(const multimap &m) = default;
+  multimap(multimap &&m) = default;
+  ~multimap() = default;
+  multimap &operator=(const multimap &m) = default;
+  multimap &operator=(multimap &&m) = default;
+
+  // the const overloads only read the tree, so concurrent readers may share
+  // one instance as long as nobody modifies it, see set
+  iterator begin() {
+    return this->GetRoot() ? iterator(this->FindMinimum(), this)
+                           : iterator(nullptr);
+  }
+  const_iterator begin() const {
+    return const_iterator(this->FindMinimum(), this);
+  }
+  iterator end() { return iterator(nullptr, this); }
+  const_iterator end() const { return const_iterator(nullptr, this); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+
+  bool empty() const { return this->root_ == nullptr; }
+  size_type size() const { return this->CntElements(); }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(Node);
+  }
+
+  void clear();
+  iterator insert(const value_type &value) {
+    return iterator(this->InsertEqualNode(this->CreateNode(value)), this);
+  }
+  iterator insert(node_type &&nh);
+  // when the key belongs right before hint it is linked there after two
+  // key comparisons instead of a descent's log n; finding the node before
+  // hint still walks O(log n) links, for end() the right spine
+  iterator insert(iterator hint, const value_type &value);
+  template <typename... Args>
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
+
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    Node *node = this->EmplaceNode(std::forward<Args>(args)...);
+    return iterator(this->InsertEqualNode(node), this);
+  }
+  template <typename... Args>
+  iterator emplace_hint(iterator hint, Args &&...args);
+
+  void erase(iterator pos) { this->DelNode(pos.node_); }
+  size_type erase(const Key &key);
+  node_type extract(iterator pos) {
+    return node_type(this->ExtractNode(pos.node_));
+  }
+  node_type extract(const Key &key) { return extract(find(key)); }
+  void swap(multimap &other);
+  void merge(multimap &other);
+
+  iterator find(const Key &key) { return iterator(Find(key), this); }
+  const_iterator find(const Key &key) const {
+    return const_iterator(Find(key), this);
+  }
+  bool contains(const Key &key) const {
+    return this->Search(key) != nullptr;
+  }
+  size_type count(const Key &key) const;
+  iterator lower_bound(const Key &key) {
+    return iterator(this->LowerBound(key), this);
+  }
+  const_iterator lower_bound(const Key &key) const {
+    return const_iterator(this->LowerBound(key), this);
+  }
+  iterator upper_bound(const Key &key) {
+    return iterator(this->UpperBound(key), this);
+  }
+  const_iterator upper_bound(const Key &key) const {
+    return const_iterator(this->UpperBound(key), this);
+  }
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+  std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  iterator find(const K &key) {
+    return iterator(Find(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  const_iterator find(const K &key) const {
+    return const_iterator(Find(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  iterator lower_bound(const K &key) {
+    return iterator(this->LowerBound(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  iterator upper_bound(const K &key) {
+    return iterator(this->UpperBound(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  const_iterator lower_bound(const K &key) const {
+    return const_iterator(this->LowerBound(key), this);
+  }
+  template <typename K>
+    requires requires { typename Compare::is_transparent; }
+  const_iterator upper_bound(const K &key) const {
+    return const_iterator(this->UpperBound(key), this);
+  }
+
+  // all zero unless built with S21_RBTREE_STATS
+  TreeStats stats() const { return this->GetStats(); }
+  void reset_stats() { this->ResetStats(); }
+
+  TreeShape inspect() const { return this->Inspect(); }
+  bool validate() const { return this->Validate(false); }
+
+ private:
+  // first node with the key, nullptr when there is none
+  template <typename K>
+  Node *Find(const K &key) const;
+};
+}  // namespace s21
+
+#include "multimap.tpp"
+
+#endif
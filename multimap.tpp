@@ -0,0 +1,100 @@
+#include "multimap.h"
+
+template <typename Key, typename T, typename Compare>
+s21::multimap<Key, T, Compare>::multimap(
+    std::initializer_list<value_type> const &items) {
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename T, typename Compare>
+void s21::multimap<Key, T, Compare>::clear() {
+  this->DelTree(this->root_);
+  this->root_ = nullptr;
+}
+
+template <typename Key, typename T, typename Compare>
+typename s21::multimap<Key, T, Compare>::iterator
+s21::multimap<Key, T, Compare>::insert(node_type &&nh) {
+  return nh.empty() ? end()
+                    : iterator(this->InsertEqualNode(nh.Release()), this);
+}
+
+template <typename Key, typename T, typename Compare>
+typename s21::multimap<Key, T, Compare>::iterator
+s21::multimap<Key, T, Compare>::insert(iterator hint,
+                                       const value_type &value) {
+  Node *node = this->CreateNode(value);
+  this->LinkNode(node, this->FindHintEqualPos(hint.node_, value.first));
+  return iterator(node, this);
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+s21::vector<
+    std::pair<typename s21::multimap<Key, T, Compare>::iterator, bool>,
+    sizeof...(Args)>
+s21::multimap<Key, T, Compare>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
+  (results.push_back(
+       std::make_pair(insert(value_type(std::forward<Args>(args))), true)),
+   ...);
+  return results;
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename... Args>
+typename s21::multimap<Key, T, Compare>::iterator
+s21::multimap<Key, T, Compare>::emplace_hint(iterator hint, Args &&...args) {
+  Node *node = this->EmplaceNode(std::forward<Args>(args)...);
+  this->LinkNode(node, this->FindHintEqualPos(hint.node_, node->data_.first));
+  return iterator(node, this);
+}
+
+template <typename Key, typename T, typename Compare>
+typename s21::multimap<Key, T, Compare>::size_type
+s21::multimap<Key, T, Compare>::erase(const Key &key) {
+  size_type n = 0;
+  iterator last = upper_bound(key);
+  for (iterator it = lower_bound(key); it != last; ++n) {
+    iterator next = it;
+    ++next;
+    erase(it);
+    it = next;
+  }
+  return n;
+}
+
+template <typename Key, typename T, typename Compare>
+void s21::multimap<Key, T, Compare>::swap(multimap &other) {
+  std::swap(this->root_, other.root_);
+  std::swap(this->comp, other.comp);
+  std::swap(this->key_of_value, other.key_of_value);
+}
+
+template <typename Key, typename T, typename Compare>
+void s21::multimap<Key, T, Compare>::merge(multimap &other) {
+  if (this != &other) {
+    while (!other.empty()) {
+      this->InsertEqualNode(other.ExtractNode(other.FindMinimum()));
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare>
+typename s21::multimap<Key, T, Compare>::size_type
+s21::multimap<Key, T, Compare>::count(const Key &key) const {
+  size_type n = 0;
+  const_iterator last = upper_bound(key);
+  for (const_iterator it = lower_bound(key); it != last; ++it) ++n;
+  return n;
+}
+
+template <typename Key, typename T, typename Compare>
+template <typename K>
+typename s21::multimap<Key, T, Compare>::Node *
+s21::multimap<Key, T, Compare>::Find(const K &key) const {
+  Node *node = this->LowerBound(key);
+  return node && !this->Less(key, node->data_.first) ? node : nullptr;
+}
@@ -4,10 +4,14 @@
 #include <cstddef>
 #include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <span>
 #include <utility>
 
 #include <vector>
 #include "rbtree.h"
+#include "sorted_file.h"
+#include "vector.h"
 
 namespace s21 {
 template <typename Key>
@@ -23,6 +27,7 @@ class multiset : private RBTree<Key, Key, MultisetKeyOfValue<Key>, Compare> {
 
   using key_type = Key;
   using value_type = Key;
+  using key_compare = Compare;
   using reference = value_type &;
   using const_reference = const value_type &;
   using iterator =
@@ -30,43 +35,151 @@ class multiset : private RBTree<Key, Key, MultisetKeyOfValue<Key>, Compare> {
   using const_iterator =
       typename BinaryTree::template Iterator<const value_type *,
                                              const_reference>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
   using size_type = size_t;
+  using node_type = NodeHandle<Key>;
 
   multiset() = default;
+  // The nodes come from resource, which has to outlive the multiset. Over a
+  // std::pmr::monotonic_buffer_resource insertion is a pointer bump, and
+  // with trivially destructible keys clear and the destructor do not walk
+  // the tree: the nodes are reclaimed by the resource's release().
+  explicit multiset(std::pmr::memory_resource *resource)
+      : BinaryTree(resource) {}
   multiset(std::initializer_list<value_type> const &items);
   multiset(const multiset &ms) = default;
   multiset(multiset &&ms) = default;
   ~multiset() = default;
   multiset &operator=(multiset &&ms) = default;
 
+  // the const overloads only read the tree, so concurrent readers may share
+  // one multiset as long as nobody modifies it, see set
   iterator begin() {
     return this->GetRoot() ? iterator(this->FindMinimum(), this)
                            : iterator(nullptr);
   }
+  const_iterator begin() const {
+    return const_iterator(this->FindMinimum(), this);
+  }
   iterator end() { return iterator(nullptr, this); }
+  const_iterator end() const { return const_iterator(nullptr, this); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
 
-  bool empty();
-  size_type size() { return this->CntElements(); }
-  size_type max_size();
+  bool empty() const;
+  size_type size() const { return this->CntElements(); }
+  size_type max_size() const;
+  // nullptr when the nodes come from plain new
+  std::pmr::memory_resource *resource() const { return this->GetResource(); }
+  // clear, the destructor and assignments detach the old tree in O(1) and
+  // hand it to r to free in slices, see reclaimer; nullptr frees in place.
+  // A set built by move takes the reclaimer along, swap and assignments
+  // leave both sets with the reclaimer they had.
+  void reclaim_with(reclaimer *r) { this->SetReclaimer(r); }
 
   void clear();
   iterator insert(const value_type &value);
+  iterator insert(node_type &&nh);
   template <typename... Args>
-  std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
   void erase(iterator pos) { this->DelNode(pos.node_); }
+  node_type extract(iterator pos) {
+    return node_type(this->ExtractNode(pos.node_), this->GetResource());
+  }
+  node_type extract(const key_type &key) { return extract(find(key)); }
   void swap(multiset &other);
   void merge(multiset &other);
 
-  size_type count(const key_type &key);
-  iterator find(const key_type &key);
+  size_type count(const key_type &key) const;
+  iterator find(const key_type &key) {
+    return iterator(FindFirst(nullptr, key), this);
+  }
+  const_iterator find(const key_type &key) const {
+    return const_iterator(FindFirst(nullptr, key), this);
+  }
   bool contains(const key_type &key) const {
     return this->Search(key) != nullptr;
   }
   std::pair<iterator, iterator> equal_range(const key_type &key) {
     return std::make_pair(lower_bound(key), upper_bound(key));
   }
-  iterator lower_bound(const key_type &key);
-  iterator upper_bound(const key_type &key);
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    return std::make_pair(lower_bound(key), upper_bound(key));
+  }
+  iterator lower_bound(const key_type &key) {
+    return iterator(this->LowerBound(key), this);
+  }
+  const_iterator lower_bound(const key_type &key) const {
+    return const_iterator(this->LowerBound(key), this);
+  }
+  iterator upper_bound(const key_type &key) {
+    return iterator(this->UpperBound(key), this);
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return const_iterator(this->UpperBound(key), this);
+  }
+  key_compare key_comp() const { return this->comp; }
+
+  // finger search: like find and lower_bound, but starting from finger,
+  // which makes them cheap when the key is close to it
+  iterator find_from(const_iterator finger, const key_type &key) {
+    return iterator(FindFirst(finger.node_, key), this);
+  }
+  const_iterator find_from(const_iterator finger, const key_type &key) const {
+    return const_iterator(FindFirst(finger.node_, key), this);
+  }
+  iterator lower_bound_from(const_iterator finger, const key_type &key) {
+    return iterator(this->LowerBoundFrom(finger.node_, key), this);
+  }
+  const_iterator lower_bound_from(const_iterator finger,
+                                  const key_type &key) const {
+    return const_iterator(this->LowerBoundFrom(finger.node_, key), this);
+  }
+
+  // find of every key, the first of its copies, with up to width lookups
+  // interleaved to overlap their cache misses; pays off on multisets that
+  // do not fit in the cache
+  std::vector<const_iterator> lookup_many(std::span<const key_type> keys,
+                                          size_type width = 16) const;
+
+  // all zero unless built with S21_RBTREE_STATS
+  TreeStats stats() const { return this->GetStats(); }
+  void reset_stats() { this->ResetStats(); }
+
+  TreeShape inspect() const { return this->Inspect(); }
+  bool validate() const { return this->Validate(false); }
+
+  // binary snapshot in the sorted file format, for trivially copyable keys;
+  // deserialize throws std::runtime_error when the input is damaged
+  void serialize(std::ostream &os) const;
+  void serialize(int fd) const;
+  static multiset deserialize(std::istream &is);
+  static multiset deserialize(int fd);
+  // O(n) build from keys already in ascending order, throws
+  // std::invalid_argument otherwise
+  static multiset from_sorted(const Key *keys, size_type n);
+
+ private:
+  // first node equal to key, searched from finger, nullptr when none is
+  Node *FindFirst(Node *finger, const key_type &key) const {
+    Node *node = this->LowerBoundFrom(finger, key);
+    return node && !this->Less(key, node->data_) ? node : nullptr;
+  }
+  static multiset Load(SortedFileReader<Key> &reader);
+  bool IsSorted(const Key *keys, size_type n) const;
 };
 }  // namespace s21
 
@@ -11,14 +11,14 @@ s21::multiset<Key, Compare>::multiset(
 }
 
 template <typename Key, typename Compare>
-bool s21::multiset<Key, Compare>::empty() {
+bool s21::multiset<Key, Compare>::empty() const {
   bool res = this->GetRoot() == nullptr ? true : false;
   return res;
 }
 
 template <typename Key, typename Compare>
 typename s21::multiset<Key, Compare>::size_type
-s21::multiset<Key, Compare>::max_size() {
+s21::multiset<Key, Compare>::max_size() const {
   using node_t = s21::RBNode<Key>;
   return std::numeric_limits<size_type>::max() / sizeof(node_t);
 }
@@ -32,36 +32,17 @@ void s21::multiset<Key, Compare>::clear() {
 template <typename Key, typename Compare>
 typename s21::multiset<Key, Compare>::iterator
 s21::multiset<Key, Compare>::insert(const value_type &value) {
-  iterator res;
-
-  if (!(this->root_)) {
-    this->root_ = new Node(value);
-    this->root_->color_ = BLACK;
-    res.node_ = this->root_;
-  } else {
-    Node *target = this->root_;
-    Node *parent = nullptr;
-    while (target) {
-      parent = target;
-      if (this->key_less(value, target->data_)) {
-        target = target->left_;
-      } else {
-        target = target->right_;
-      }
-    }
-
-    target = new Node(value);
-    target->parent_ = parent;
-
-    if (this->key_less(value, parent->data_)) {
-      parent->left_ = target;
-    } else {
-      parent->right_ = target;
-    }
-
-    this->Balance(target);
+  return iterator(this->InsertEqualNode(this->CreateNode(value)), this);
+}
 
-    res.node_ = target;
+template <typename Key, typename Compare>
+typename s21::multiset<Key, Compare>::iterator
+s21::multiset<Key, Compare>::insert(node_type &&nh) {
+  iterator res = end();
+  if (!nh.empty()) {
+    res = iterator(
+        this->InsertEqualNode(this->AdoptNode(nh.Release(), nh.resource())),
+        this);
   }
 
   return res;
@@ -69,9 +50,10 @@ s21::multiset<Key, Compare>::insert(const value_type &value) {
 
 template <typename Key, typename Compare>
 template <typename... Args>
-std::vector<std::pair<typename s21::multiset<Key, Compare>::iterator, bool>>
+s21::vector<std::pair<typename s21::multiset<Key, Compare>::iterator, bool>,
+            sizeof...(Args)>
 s21::multiset<Key, Compare>::insert_many(Args &&...args) {
-  std::vector<std::pair<iterator, bool>> results;
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
 
   for (auto value : std::initializer_list<value_type>{args...}) {
     iterator it = insert(value);
@@ -86,6 +68,7 @@ void s21::multiset<Key, Compare>::swap(multiset &other) {
   auto tmp_root = this->root_;
   this->root_ = other.root_;
   other.root_ = tmp_root;
+  std::swap(this->resource_, other.resource_);
 
   auto tmp_comp = this->comp;
   this->comp = other.comp;
@@ -100,67 +83,103 @@ template <typename Key, typename Compare>
 void s21::multiset<Key, Compare>::merge(multiset &other) {
   if (this != &other) {
     while (!other.empty()) {
-      insert(*other.begin());
-      other.erase(other.begin());
+      this->InsertEqualNode(this->AdoptNode(
+          other.ExtractNode(other.FindMinimum()), other.resource_));
     }
   }
 }
 
+template <typename Key, typename Compare>
+std::vector<typename s21::multiset<Key, Compare>::const_iterator>
+s21::multiset<Key, Compare>::lookup_many(std::span<const key_type> keys,
+                                         size_type width) const {
+  std::vector<const_iterator> res(keys.size(), end());
+  this->LowerBoundMany(keys, width, [&](size_t i, Node *node) {
+    if (node && !this->Less(keys[i], node->data_)) {
+      res[i].node_ = node;
+    }
+  });
+  return res;
+}
+
 template <typename Key, typename Compare>
 typename s21::multiset<Key, Compare>::size_type
-s21::multiset<Key, Compare>::count(const key_type &key) {
-  iterator first = lower_bound(key);
-  iterator last = upper_bound(key);
+s21::multiset<Key, Compare>::count(const key_type &key) const {
+  const_iterator first = lower_bound(key);
+  const_iterator last = upper_bound(key);
   size_type n = 0;
-  for (iterator it = first; it != last; ++it) ++n;
+  for (const_iterator it = first; it != last; ++it) ++n;
   return n;
 }
 
 template <typename Key, typename Compare>
-typename s21::multiset<Key, Compare>::iterator
-s21::multiset<Key, Compare>::find(const key_type &key) {
-  iterator res = lower_bound(key);
+void s21::multiset<Key, Compare>::serialize(std::ostream &os) const {
+  SortedFileWriter<Key> writer(os, true);
+  this->ForEach([&writer](const Key &key) { writer.Add(key); });
+  writer.Finish();
+}
+
+template <typename Key, typename Compare>
+void s21::multiset<Key, Compare>::serialize(int fd) const {
+  SortedFileWriter<Key> writer(fd, true);
+  this->ForEach([&writer](const Key &key) { writer.Add(key); });
+  writer.Finish();
+}
 
-  if (res.node_ && this->comp(key, *res)) {
-    res = end();
+template <typename Key, typename Compare>
+s21::multiset<Key, Compare> s21::multiset<Key, Compare>::deserialize(
+    std::istream &is) {
+  SortedFileReader<Key> reader(is);
+  return Load(reader);
+}
+
+template <typename Key, typename Compare>
+s21::multiset<Key, Compare> s21::multiset<Key, Compare>::deserialize(int fd) {
+  SortedFileReader<Key> reader(fd);
+  return Load(reader);
+}
+
+template <typename Key, typename Compare>
+s21::multiset<Key, Compare> s21::multiset<Key, Compare>::Load(
+    SortedFileReader<Key> &reader) {
+  const size_t chunk = 1 << 16;
+  std::vector<Key> keys;
+  size_t got = chunk;
+  while (got == chunk) {
+    size_t old = keys.size();
+    keys.resize(old + chunk);
+    got = reader.Read(keys.data() + old, chunk);
+    keys.resize(old + got);
   }
+  reader.Verify();
+
+  multiset res;
+  if (!res.IsSorted(keys.data(), keys.size())) {
+    throw std::runtime_error("sorted file: keys are not ordered");
+  }
+  res.BuildFromSorted(keys.data(), keys.size());
 
   return res;
 }
 
-// first element not less than the given
 template <typename Key, typename Compare>
-typename s21::multiset<Key, Compare>::iterator
-s21::multiset<Key, Compare>::lower_bound(const key_type &key) {
-  Node *tmp = this->root_;
-  Node *cand = nullptr;
-
-  while (tmp) {
-    if (this->comp(tmp->data_, key)) {
-      tmp = tmp->right_;
-    } else {
-      cand = tmp;
-      tmp = tmp->left_;
-    }
+s21::multiset<Key, Compare> s21::multiset<Key, Compare>::from_sorted(
+    const Key *keys, size_type n) {
+  multiset res;
+  if (!res.IsSorted(keys, n)) {
+    throw std::invalid_argument("multiset: keys are not ordered");
   }
-
-  return iterator(cand);
+  res.BuildFromSorted(keys, n);
+  return res;
 }
 
 template <typename Key, typename Compare>
-typename s21::multiset<Key, Compare>::iterator
-s21::multiset<Key, Compare>::upper_bound(const key_type &key) {
-  Node *tmp = this->root_;
-  Node *cand = nullptr;
-
-  while (tmp) {
-    if (this->comp(key, tmp->data_)) {
-      cand = tmp;
-      tmp = tmp->left_;
-    } else {
-      tmp = tmp->right_;
+bool s21::multiset<Key, Compare>::IsSorted(const Key *keys,
+                                           size_type n) const {
+  for (size_type i = 1; i < n; ++i) {
+    if (this->comp(keys[i], keys[i - 1])) {
+      return false;
     }
   }
-
-  return iterator(cand);
-}
\ No newline at end of file
+  return true;
+}
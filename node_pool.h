@@ -0,0 +1,111 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+// Fixed-size slot allocator for the nodes of one container type. Slots are
+// carved from blocks that double in size up to kMaxBlock slots, freed slots
+// go to an intrusive free list and are handed out again first, and the
+// blocks are released only with the pool. A node costs exactly one slot,
+// without the malloc header and size-class rounding of a plain new.
+//
+// Not thread-safe: containers sharing a pool must stay on one thread.
+template <typename Node>
+class NodePool {
+ public:
+  NodePool() = default;
+  NodePool(const NodePool &) = delete;
+  NodePool &operator=(const NodePool &) = delete;
+  ~NodePool() {
+    for (auto &block : blocks_) {
+      std::allocator<Slot>().deallocate(block.first, block.second);
+    }
+  }
+
+  // uninitialized storage for one node
+  void *Allocate() {
+    Slot *slot = free_;
+    if (slot) {
+      free_ = slot->next_;
+    } else {
+      if (next_ == end_) {
+        Grow();
+      }
+      slot = next_++;
+    }
+    ++in_use_;
+    return slot;
+  }
+
+  // takes back storage of a node that is already destroyed
+  void Deallocate(void *p) {
+    Slot *slot = static_cast<Slot *>(p);
+    slot->next_ = free_;
+    free_ = slot;
+    --in_use_;
+  }
+
+  // whether p is a slot of this pool, in O(log blocks)
+  bool Owns(const void *p) const {
+    const Slot *slot = static_cast<const Slot *>(p);
+    auto it = std::upper_bound(
+        blocks_.begin(), blocks_.end(), slot,
+        [](const Slot *s, const std::pair<Slot *, size_t> &block) {
+          return std::less<const Slot *>()(s, block.first);
+        });
+    if (it == blocks_.begin()) {
+      return false;
+    }
+    --it;
+    return std::less<const Slot *>()(slot, it->first + it->second);
+  }
+
+  size_t in_use() const { return in_use_; }
+  // slots carved so far, in use or free
+  size_t capacity() const { return capacity_; }
+  size_t allocated_bytes() const { return capacity_ * sizeof(Slot); }
+  static constexpr size_t slot_size() { return sizeof(Slot); }
+
+ private:
+  union Slot {
+    Slot *next_;
+    alignas(Node) unsigned char node_[sizeof(Node)];
+  };
+
+  static constexpr size_t kMinBlock = 16;
+  static constexpr size_t kMaxBlock = 4096;
+
+  // blocks_ stays sorted by address for Owns
+  void Grow() {
+    size_t n = last_block_ ? std::min(last_block_ * 2, kMaxBlock) : kMinBlock;
+    blocks_.reserve(blocks_.size() + 1);
+    Slot *block = std::allocator<Slot>().allocate(n);
+    auto pos = std::upper_bound(
+        blocks_.begin(), blocks_.end(), block,
+        [](const Slot *s, const std::pair<Slot *, size_t> &b) {
+          return std::less<const Slot *>()(s, b.first);
+        });
+    blocks_.emplace(pos, block, n);
+    last_block_ = n;
+    next_ = block;
+    end_ = block + n;
+    capacity_ += n;
+  }
+
+  Slot *free_ = nullptr;
+  Slot *next_ = nullptr;
+  Slot *end_ = nullptr;
+  std::vector<std::pair<Slot *, size_t>> blocks_;
+  size_t last_block_ = 0;
+  size_t capacity_ = 0;
+  size_t in_use_ = 0;
+};
+}  // namespace s21
+
+#endif
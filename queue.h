@@ -0,0 +1,58 @@
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "ring_buffer.h"
+
+namespace s21 {
+// FIFO queue over a power-of-two ring buffer: no nodes, and no allocation
+// once the buffer has grown to the largest size the queue reaches.
+template <typename T>
+class queue {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  queue() = default;
+  queue(std::initializer_list<value_type> const &items);
+  queue(const queue &q) = default;
+  queue(queue &&q) noexcept = default;
+  ~queue() = default;
+  queue &operator=(const queue &q) = default;
+  queue &operator=(queue &&q) noexcept = default;
+
+  const_reference front() const { return ring_.Front(); }
+  reference front() { return ring_.Front(); }
+  const_reference back() const { return ring_.Back(); }
+  reference back() { return ring_.Back(); }
+
+  bool empty() const { return ring_.Size() == 0; }
+  size_type size() const { return ring_.Size(); }
+  size_type capacity() const { return ring_.Capacity(); }
+  void reserve(size_type n) { ring_.Reserve(n); }
+
+  void push(const_reference value) { ring_.EmplaceBack(value); }
+  void push(T &&value) { ring_.EmplaceBack(std::move(value)); }
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return ring_.EmplaceBack(std::forward<Args>(args)...);
+  }
+  void pop() { ring_.PopFront(); }
+  void swap(queue &other) noexcept { ring_.Swap(other.ring_); }
+
+  template <typename... Args>
+  void insert_many_back(Args &&...args);
+
+ private:
+  RingBuffer<T> ring_;
+};
+}  // namespace s21
+
+#include "queue.tpp"
+
+#endif
@@ -0,0 +1,16 @@
+#include "queue.h"
+
+template <typename T>
+s21::queue<T>::queue(std::initializer_list<value_type> const &items) {
+  ring_.Reserve(items.size());
+  for (const auto &item : items) {
+    push(item);
+  }
+}
+
+template <typename T>
+template <typename... Args>
+void s21::queue<T>::insert_many_back(Args &&...args) {
+  ring_.Reserve(size() + sizeof...(Args));
+  (ring_.EmplaceBack(std::forward<Args>(args)), ...);
+}
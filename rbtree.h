@@ -1,21 +1,50 @@
 #ifndef RB_TREE_H
 #define RB_TREE_H
 
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "interleave.h"
+#include "reclaimer.h"
+#include "tree_stats.h"
 
 namespace s21 {
 typedef enum { RED, BLACK } Color;
 
-template <typename DataType>
+// Augmentation policy of RBTree: every node carries an aggregate of its
+// subtree, Update recomputes it from the node and its children and is called
+// bottom-up whenever the shape below a node changes.
+struct NoAugment {
+  struct value_type {};
+  static constexpr bool kEnabled = false;
+
+  template <typename Node>
+  static void Update(Node *) {}
+};
+
+template <typename DataType, typename Augment = NoAugment>
 class RBNode {
  public:
   DataType data_;
   Color color_;
 
   RBNode *left_, *right_, *parent_;
+  [[no_unique_address]] typename Augment::value_type aug_;
 
  public:
   RBNode() {
@@ -32,22 +61,116 @@ class RBNode {
         left_(nullptr),
         right_(nullptr),
         parent_(nullptr) {}
+
+  // builds the value from args, for values that are costly or impossible to
+  // copy into place
+  template <typename... Args>
+  explicit RBNode(std::in_place_t, Args &&...args)
+      : data_(std::forward<Args>(args)...),
+        color_(RED),
+        left_(nullptr),
+        right_(nullptr),
+        parent_(nullptr) {}
+};
+
+// nodes come from resource, or from plain new when it is nullptr
+template <typename Node, typename... Args>
+Node *NewNode(std::pmr::memory_resource *resource, Args &&...args) {
+  if (!resource) {
+    return new Node(std::forward<Args>(args)...);
+  }
+  void *p = resource->allocate(sizeof(Node), alignof(Node));
+  try {
+    return ::new (p) Node(std::forward<Args>(args)...);
+  } catch (...) {
+    resource->deallocate(p, sizeof(Node), alignof(Node));
+    throw;
+  }
+}
+
+template <typename Node>
+void DeleteNode(std::pmr::memory_resource *resource, Node *node) {
+  if (!resource) {
+    delete node;
+  } else if (node) {
+    node->~Node();
+    resource->deallocate(node, sizeof(Node), alignof(Node));
+  }
+}
+
+template <typename DataType, typename Augment = NoAugment>
+class NodeHandle {
+ public:
+  using value_type = DataType;
+
+  NodeHandle() = default;
+  // resource is the one node was allocated from
+  explicit NodeHandle(RBNode<DataType, Augment> *node,
+                      std::pmr::memory_resource *resource = nullptr)
+      : node_(node), resource_(resource) {}
+  NodeHandle(const NodeHandle &) = delete;
+  NodeHandle(NodeHandle &&other) noexcept
+      : node_(other.node_), resource_(other.resource_) {
+    other.node_ = nullptr;
+  }
+  ~NodeHandle() { DeleteNode(resource_, node_); }
+
+  NodeHandle &operator=(const NodeHandle &) = delete;
+  NodeHandle &operator=(NodeHandle &&other) noexcept {
+    if (this != &other) {
+      DeleteNode(resource_, node_);
+      node_ = other.node_;
+      resource_ = other.resource_;
+      other.node_ = nullptr;
+    }
+    return *this;
+  }
+
+  bool empty() const { return node_ == nullptr; }
+  explicit operator bool() const { return node_ != nullptr; }
+  value_type &value() const { return node_->data_; }
+
+  // gives the node back to a tree, the handle becomes empty
+  RBNode<DataType, Augment> *Release() {
+    RBNode<DataType, Augment> *node = node_;
+    node_ = nullptr;
+    return node;
+  }
+  std::pmr::memory_resource *resource() const { return resource_; }
+
+ private:
+  RBNode<DataType, Augment> *node_ = nullptr;
+  std::pmr::memory_resource *resource_ = nullptr;
 };
 
 template <typename DataType, typename Key, typename KeyOfValue,
-          typename Compare = std::less<Key>>
+          typename Compare = std::less<Key>, typename Augment = NoAugment,
+          typename Stats = DefaultTreeStats>
 class RBTree {
  public:
+  using Node = RBNode<DataType, Augment>;
+
   template <typename Pointer, typename Reference>
   class Iterator {
    public:
-    RBNode<DataType> *node_ = nullptr;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = DataType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Pointer;
+    using reference = Reference;
+
+    Node *node_ = nullptr;
     const RBTree *owner_ = nullptr;
 
     Iterator() = default;
-    Iterator(RBNode<DataType> *node) : node_(node), owner_(nullptr) {}
-    Iterator(RBNode<DataType> *node, RBTree *owner)
+    Iterator(Node *node) : node_(node), owner_(nullptr) {}
+    Iterator(Node *node, const RBTree *owner)
         : node_(node), owner_(owner) {}
+    // iterator converts to const_iterator
+    template <typename P, typename R>
+      requires std::is_convertible_v<P, Pointer>
+    Iterator(const Iterator<P, R> &other)
+        : node_(other.node_), owner_(other.owner_) {}
 
     Reference operator*() const { return node_->data_; }
     Pointer operator->() const { return &node_->data_; }
@@ -59,7 +182,7 @@ class RBTree {
           node_ = node_->left_;
         }
       } else if (node_) {
-        RBNode<DataType> *parent = node_->parent_;
+        Node *parent = node_->parent_;
         while (parent && node_ == parent->right_) {
           node_ = parent;
           parent = parent->parent_;
@@ -69,6 +192,11 @@ class RBTree {
 
       return *this;
     }
+    Iterator operator++(int) {
+      Iterator res = *this;
+      ++*this;
+      return res;
+    }
 
     Iterator &operator--() & {
       if (node_) {
@@ -78,7 +206,7 @@ class RBTree {
             node_ = node_->right_;
           }
         } else {
-          RBNode<DataType> *p = node_->parent_;
+          Node *p = node_->parent_;
           while (p && node_ == p->left_) {
             node_ = p;
             p = p->parent_;
@@ -98,13 +226,16 @@ class RBTree {
 
       return *this;
     }
+    Iterator operator--(int) {
+      Iterator res = *this;
+      --*this;
+      return res;
+    }
 
-    bool operator==(const Iterator &other) const {
+    template <typename P, typename R>
+    bool operator==(const Iterator<P, R> &other) const {
       return node_ == other.node_;
     }
-    bool operator!=(const Iterator &other) const {
-      return node_ != other.node_;
-    }
   };
 
  public:
@@ -112,26 +243,41 @@ class RBTree {
   Compare comp;
 
   bool key_less(const DataType &a, const DataType &b) const {
-    return comp(key_of_value(a), key_of_value(b));
+    return Less(key_of_value(a), key_of_value(b));
+  }
+
+  // every key comparison of the tree goes through here to be counted; the
+  // operands may differ from Key only with a transparent Compare
+  template <typename A, typename B>
+  bool Less(const A &a, const B &b) const {
+    stats_.OnCompare();
+    return comp(a, b);
   }
 
   RBTree() { root_ = nullptr; }
+  // the nodes come from resource, which has to outlive the tree
+  explicit RBTree(std::pmr::memory_resource *resource)
+      : root_(nullptr), resource_(resource) {}
   RBTree(const DataType data) {
-    root_ = new RBNode<DataType>(data);
+    root_ = CreateNode(data);
     root_->color_ = BLACK;
   }
   RBTree(const RBTree &other) {
     root_ = CloneSubtree(other.root_, nullptr);
     comp = other.comp;
   }
+  // a copy allocates with plain new, a move takes the resource along
   RBTree(RBTree &&other) {
     root_ = other.root_;
+    resource_ = other.resource_;
+    SetReclaimer(other.reclaimer_);
     comp = other.comp;
     other.root_ = nullptr;
   }
   ~RBTree() {
     DelTree(root_);
     this->root_ = nullptr;
+    SetReclaimer(nullptr);
   }
 
   RBTree &operator=(const RBTree &other) {
@@ -143,108 +289,399 @@ class RBTree {
     return *this;
   }
 
+  // the tree keeps its resource, nodes of another one are copied over
   RBTree &operator=(RBTree &&other) {
     if (this != &other) {
       DelTree(root_);
-      root_ = other.root_;
+      if (resource_ == other.resource_) {
+        root_ = other.root_;
+      } else {
+        root_ = CloneSubtree(other.root_, nullptr);
+        other.DelTree(other.root_);
+      }
       comp = std::move(other.comp);
       other.root_ = nullptr;
     }
     return *this;
   }
 
+  // where a key would be linked: found_ is set when an equal key exists
+  struct InsertPos {
+    Node *parent_ = nullptr;
+    Node *found_ = nullptr;
+    bool left_ = false;
+  };
+
   int Insert(const DataType &data) {
-    int flag = 1;
-    if (!root_) {
-      root_ = new RBNode<DataType>(data);
-      root_->color_ = BLACK;
-    } else {
-      RBNode<DataType> *target = root_;
-      RBNode<DataType> *parent = nullptr;
-      while (target && flag) {
-        parent = target;
-        if (key_less(data, target->data_)) {
-          target = target->left_;
-        } else if (key_less(target->data_, data)) {
-          target = target->right_;
-        } else {
-          flag = 0;
-        }
+    InsertPos pos = FindUniquePos(key_of_value(data));
+    if (!pos.found_) {
+      LinkNode(CreateNode(data), pos);
+    }
+
+    return pos.found_ ? 0 : 1;
+  }
+
+  InsertPos FindUniquePos(const Key &key) const {
+    InsertPos pos;
+    Node *cur = root_;
+    size_t depth = 0;
+    while (cur && !pos.found_) {
+      pos.parent_ = cur;
+      ++depth;
+      if (Less(key, key_of_value(cur->data_))) {
+        pos.left_ = true;
+        cur = cur->left_;
+      } else if (Less(key_of_value(cur->data_), key)) {
+        pos.left_ = false;
+        cur = cur->right_;
+      } else {
+        pos.found_ = cur;
       }
+    }
+    stats_.OnLookup(depth);
 
-      if (flag) {
-        target = new RBNode<DataType>(data);
-        target->parent_ = parent;
+    return pos;
+  }
 
-        if (key_less(data, parent->data_)) {
-          parent->left_ = target;
-        } else {
-          parent->right_ = target;
+  // equal keys go after the existing ones
+  InsertPos FindEqualPos(const Key &key) const {
+    InsertPos pos;
+    Node *cur = root_;
+    size_t depth = 0;
+    while (cur) {
+      pos.parent_ = cur;
+      ++depth;
+      pos.left_ = Less(key, key_of_value(cur->data_));
+      cur = pos.left_ ? cur->left_ : cur->right_;
+    }
+    stats_.OnLookup(depth);
+
+    return pos;
+  }
+
+  // attaches a detached node at pos and restores the red-black properties
+  void LinkNode(Node *node, const InsertPos &pos) {
+    node->parent_ = pos.parent_;
+    node->left_ = nullptr;
+    node->right_ = nullptr;
+    node->color_ = RED;
+
+    if (!pos.parent_) {
+      root_ = node;
+    } else if (pos.left_) {
+      pos.parent_->left_ = node;
+    } else {
+      pos.parent_->right_ = node;
+    }
+
+    UpdatePath(node);
+    Balance(node);
+  }
+
+  std::pair<Node *, bool> InsertUniqueNode(Node *node) {
+    InsertPos pos = FindUniquePos(key_of_value(node->data_));
+    if (!pos.found_) {
+      LinkNode(node, pos);
+    }
+
+    return pos.found_ ? std::make_pair(pos.found_, false)
+                      : std::make_pair(node, true);
+  }
+
+  Node *InsertEqualNode(Node *node) {
+    LinkNode(node, FindEqualPos(key_of_value(node->data_)));
+    return node;
+  }
+
+  // FindUniquePos that first tries the slot right before hint (nullptr for
+  // the end) with two comparisons. Reaching the node before hint walks up
+  // to the height of the tree in links, the right spine for the end, so a
+  // good hint saves the comparisons of a descent but not its length
+  InsertPos FindHintUniquePos(Node *hint, const Key &key) const {
+    Node *prev = hint ? Predecessor(hint) : FindMaximum();
+    if ((!hint || Less(key, key_of_value(hint->data_))) &&
+        (!prev || Less(key_of_value(prev->data_), key))) {
+      return PosBetween(prev, hint);
+    }
+    return FindUniquePos(key);
+  }
+
+  InsertPos FindHintEqualPos(Node *hint, const Key &key) const {
+    Node *prev = hint ? Predecessor(hint) : FindMaximum();
+    if ((!hint || !Less(key_of_value(hint->data_), key)) &&
+        (!prev || !Less(key, key_of_value(prev->data_)))) {
+      return PosBetween(prev, hint);
+    }
+    return FindEqualPos(key);
+  }
+
+  // first node not less than key, nullptr when there is none
+  template <typename K>
+  Node *LowerBound(const K &key) const {
+    return LowerBoundBelow(root_, nullptr, key, 0);
+  }
+
+  // LowerBound that starts at finger (nullptr for the end) instead of the
+  // root: it climbs only until the subtree reached is known to hold the
+  // answer, then descends from there. The cost is the height of the
+  // smallest subtree holding both, O(log d) on average for a key d
+  // positions away from the finger, rather than the height of the tree
+  template <typename K>
+  Node *LowerBoundFrom(Node *finger, const K &key) const {
+    if (!finger) {
+      return LowerBound(key);
+    }
+    Node *cur = finger;
+    Node *cand = nullptr;
+    size_t depth = 0;
+    if (Less(key_of_value(finger->data_), key)) {
+      // the answer lies after the finger: stop below the first ancestor
+      // not less than key, it bounds the subtree and is the fallback
+      while (cur->parent_) {
+        ++depth;
+        Node *parent = cur->parent_;
+        if (cur == parent->left_ &&
+            !Less(key_of_value(parent->data_), key)) {
+          cand = parent;
+          break;
+        }
+        cur = parent;
+      }
+    } else {
+      // the answer is the finger or before it: stop below the first
+      // ancestor on the left that is less than key
+      while (cur->parent_) {
+        ++depth;
+        Node *parent = cur->parent_;
+        if (cur == parent->right_ && Less(key_of_value(parent->data_), key)) {
+          break;
         }
+        cur = parent;
+      }
+    }
+    return LowerBoundBelow(cur, cand, key, depth);
+  }
 
-        Balance(target);
+  // LowerBound of every key of keys, handed to visit(i, node) in any order.
+  // Up to width descents run interleaved on this thread: each prefetches
+  // the child it reads next and yields to the others, so on a tree much
+  // larger than the cache their misses overlap instead of adding up
+  template <typename K, typename Visit>
+  void LowerBoundMany(std::span<const K> keys, size_t width,
+                      const Visit &visit) const {
+    std::vector<InterleavedTask> tasks;
+    size_t next = 0;
+    width = std::max<size_t>(width, 1);
+    while (tasks.size() < width && tasks.size() < keys.size()) {
+      tasks.push_back(LowerBoundTask(keys, next, visit));
+    }
+    Interleave(tasks);
+  }
+
+  // first node greater than key, nullptr when there is none
+  template <typename K>
+  Node *UpperBound(const K &key) const {
+    Node *cur = root_;
+    Node *cand = nullptr;
+    size_t depth = 0;
+    while (cur) {
+      ++depth;
+      if (Less(key, key_of_value(cur->data_))) {
+        cand = cur;
+        cur = cur->left_;
+      } else {
+        cur = cur->right_;
       }
     }
+    stats_.OnLookup(depth);
 
-    return flag;
+    return cand;
   }
 
-  RBNode<DataType> *Search(const Key &key) const {
+  Node *Search(const Key &key) const {
     int flag = 1;
-    RBNode<DataType> *cur = root_;
+    Node *cur = root_;
+    size_t depth = 0;
 
     if (root_) {
       while (cur && flag) {
-        if (!(comp(key_of_value(cur->data_), key)) &&
-            !(comp(key, key_of_value(cur->data_)))) {
+        ++depth;
+        if (!(Less(key_of_value(cur->data_), key)) &&
+            !(Less(key, key_of_value(cur->data_)))) {
           flag = 0;
-        } else if (comp(key, key_of_value(cur->data_))) {
+        } else if (Less(key, key_of_value(cur->data_))) {
           cur = cur->left_;
         } else {
           cur = cur->right_;
         }
       }
     }
+    stats_.OnLookup(depth);
 
-    RBNode<DataType> *res = flag == 0 ? cur : nullptr;
+    Node *res = flag == 0 ? cur : nullptr;
 
     return res;
   }
 
-  RBNode<DataType> *FindMinimum() const {
+  Node *FindMinimum() const {
     return root_ ? SupportFindMinimum(root_) : nullptr;
   }
 
-  RBNode<DataType> *GetRoot() const { return root_; }
+  Node *FindMaximum() const {
+    Node *cur = root_;
+    while (cur && cur->right_) {
+      cur = cur->right_;
+    }
+    return cur;
+  }
+
+  Node *GetRoot() const { return root_; }
+  std::pmr::memory_resource *GetResource() const { return resource_; }
+  reclaimer *GetReclaimer() const { return reclaimer_; }
+  void SetReclaimer(reclaimer *r) {
+    if (reclaimer_) {
+      reclaimer_->Detach(&reclaimer_);
+    }
+    reclaimer_ = r;
+    if (reclaimer_) {
+      reclaimer_->Attach(&reclaimer_);
+    }
+  }
+
+  TreeStats GetStats() const { return stats_.Snapshot(); }
+  void ResetStats() { stats_.Reset(); }
 
-  size_t CntElements() {
+  TreeShape Inspect() const {
+    TreeShape shape;
+    InspectSupport(root_, 0, &shape);
+    shape.height = shape.depth_histogram.size();
+    for (Node *cur = root_; cur; cur = cur->left_) {
+      shape.black_height += cur->color_ == BLACK;
+    }
+    shape.node_bytes = shape.size * sizeof(Node);
+    shape.payload_bytes = shape.size * sizeof(DataType);
+
+    return shape;
+  }
+
+  // O(n) check of the search order, the parent links, the red-black rules
+  // and the augmented values; unique forbids equal neighbours
+  bool Validate(bool unique) const {
+    bool res = !root_ || (!root_->parent_ && root_->color_ == BLACK);
+    const Node *prev = nullptr;
+    res = res && ValidateSupport(root_, &prev, unique) >= 0;
+    return res;
+  }
+
+  // calls fn for every value in order
+  template <typename Fn>
+  void ForEach(Fn fn) const {
+    for (Node *cur = FindMinimum(); cur;) {
+      fn(static_cast<const DataType &>(cur->data_));
+      if (cur->right_) {
+        cur = SupportFindMinimum(cur->right_);
+      } else {
+        while (cur->parent_ && cur == cur->parent_->right_) {
+          cur = cur->parent_;
+        }
+        cur = cur->parent_;
+      }
+    }
+  }
+
+  // Replaces the contents with n values that are already in order, in O(n).
+  // The tree is split at the middle, so all leaves lie on the last two
+  // levels; the last level is red unless it is full. If a node cannot be
+  // made the tree is left empty.
+  void BuildFromSorted(const DataType *data, size_t n) {
+    DelTree(root_);
+    root_ = nullptr;
+    size_t last = 0;
+    while ((size_t(2) << last) - 1 < n) {
+      ++last;
+    }
+    bool full = ((n + 1) & n) == 0;
+    root_ = BuildSupport(data, 0, n, nullptr, 0, full ? n : last);
+  }
+
+  size_t CntElements() const {
     size_t cnt = 0;
     CntElementsSupport(root_, &cnt);
     return cnt;
   }
 
-  void DelTree(RBNode<DataType> *root) {
+  // A monotonic resource frees nothing before release(), so when no node
+  // needs its destructor the walk over the tree is skipped altogether and
+  // the memory goes back with the resource. With a reclaimer the tree is
+  // handed over whole and freed later.
+  void DelTree(Node *root) {
+    if constexpr (std::is_trivially_destructible_v<Node>) {
+      if (dynamic_cast<std::pmr::monotonic_buffer_resource *>(resource_)) {
+        return;
+      }
+    }
+    if (reclaimer_ && root) {
+      root->parent_ = nullptr;
+      reclaimer_->Adopt(root, resource_, &ReclaimSlice);
+      return;
+    }
+    DelSubtree(root);
+  }
+
+  // Resumable teardown for the reclaimer, in O(1) space: a node without a
+  // left child is freed and its right subtree is next, otherwise a right
+  // rotation lifts the left child above it. Every rotation takes one more
+  // node out of the left spines, so a tree of n nodes takes under 2n steps.
+  static size_t ReclaimSlice(void **root, std::pmr::memory_resource *resource,
+                             size_t steps) {
+    Node *cur = static_cast<Node *>(*root);
+    size_t freed = 0;
+    for (; cur && steps; --steps) {
+      if (Node *left = cur->left_) {
+        cur->left_ = left->right_;
+        left->right_ = cur;
+        cur = left;
+      } else {
+        Node *next = cur->right_;
+        DeleteNode(resource, cur);
+        cur = next;
+        ++freed;
+      }
+    }
+    *root = cur;
+    return freed;
+  }
+
+  void DelSubtree(Node *root) {
     if (root) {
-      DelTree(root->left_);
-      DelTree(root->right_);
-      delete root;
+      DelSubtree(root->left_);
+      DelSubtree(root->right_);
+      DestroyNode(root);
+    }
+  }
+
+  void DelNode(Node *n) {
+    if (n) {
+      DestroyNode(ExtractNode(n));
     }
   }
 
-  void DelNode(RBNode<DataType> *n) {
+  // unlinks n from the tree without freeing it, the node keeps its data
+  Node *ExtractNode(Node *n) {
     if (!n) {
-      return;
+      return nullptr;
     }
     int ch = CntChild(n);
 
     if (n->color_ == RED && ch == 0) {
+      Node *p = n->parent_;
       ChangeConnections(n, nullptr);
-      delete n;
+      UpdatePath(p);
     } else if (ch == 2) {
-      RBNode<DataType> *el_for_swap = SupportFindMinimum(n->right_);
+      Node *el_for_swap = SupportFindMinimum(n->right_);
       Color his_clr = el_for_swap->color_;
-      RBNode<DataType> *his_chld = el_for_swap->right_;
-      RBNode<DataType> *parent_his_ch = nullptr;
+      Node *his_chld = el_for_swap->right_;
+      Node *parent_his_ch = nullptr;
 
       if (el_for_swap->parent_ == n) {
         parent_his_ch = el_for_swap;
@@ -261,40 +698,132 @@ class RBTree {
         el_for_swap->left_->parent_ = el_for_swap;
       }
       el_for_swap->color_ = n->color_;
-
-      delete n;
+      stats_.OnRecolor(1);
+      UpdatePath(parent_his_ch);
 
       if (his_clr == BLACK) {
         DeleteFixup(his_chld, parent_his_ch);
       }
     } else if (n->color_ == BLACK && ch == 0) {
-      RBNode<DataType> *p = n->parent_;
+      Node *p = n->parent_;
       ChangeConnections(n, nullptr);
-      delete n;
+      UpdatePath(p);
       DeleteFixup(nullptr, p);
     } else if (n->color_ == BLACK && ch == 1) {
-      RBNode<DataType> *child = n->left_ ? n->left_ : n->right_;
+      Node *child = n->left_ ? n->left_ : n->right_;
       ChangeConnections(n, child);
       child->color_ = BLACK;
-      delete n;
+      stats_.OnRecolor(1);
+      UpdatePath(child->parent_);
     }
 
-    return;
+    n->left_ = nullptr;
+    n->right_ = nullptr;
+    n->parent_ = nullptr;
+    n->color_ = RED;
+
+    return n;
   }
 
  protected:
-  RBNode<DataType> *root_;
+  // one descent of LowerBoundMany after another, taking the next key from
+  // next until none are left
+  template <typename K, typename Visit>
+  InterleavedTask LowerBoundTask(std::span<const K> keys, size_t &next,
+                                 const Visit &visit) const {
+    while (next < keys.size()) {
+      size_t i = next++;
+      Node *cur = root_;
+      Node *cand = nullptr;
+      size_t depth = 0;
+      while (cur) {
+        ++depth;
+        if (Less(key_of_value(cur->data_), keys[i])) {
+          cur = cur->right_;
+        } else {
+          cand = cur;
+          cur = cur->left_;
+        }
+        if (cur) {
+          co_await PrefetchAndYield(cur);
+        }
+      }
+      stats_.OnLookup(depth);
+      visit(i, cand);
+    }
+  }
+
+  Node *root_;
+  // nullptr for plain new and delete
+  std::pmr::memory_resource *resource_ = nullptr;
+  // nullptr frees the nodes in place
+  reclaimer *reclaimer_ = nullptr;
+  [[no_unique_address]] Stats stats_;
+
+  // first node not less than key in the subtree of cur, cand when there is
+  // none; depth is the path length so far, for the lookup stats
+  template <typename K>
+  Node *LowerBoundBelow(Node *cur, Node *cand, const K &key,
+                        size_t depth) const {
+    while (cur) {
+      ++depth;
+      if (Less(key_of_value(cur->data_), key)) {
+        cur = cur->right_;
+      } else {
+        cand = cur;
+        cur = cur->left_;
+      }
+    }
+    stats_.OnLookup(depth);
 
-  Color ColorOf(RBNode<DataType> *x) { return x ? x->color_ : BLACK; }
-  void SetColor(RBNode<DataType> *x, Color clr) {
-    if (x) x->color_ = clr;
+    return cand;
   }
-  void DeleteFixup(RBNode<DataType> *x, RBNode<DataType> *parent) {
+
+  Node *CreateNode(const DataType &data) {
+    if (reclaimer_) {
+      reclaimer_->Assist();
+    }
+    stats_.OnAllocate();
+    return NewNode<Node>(resource_, data);
+  }
+  template <typename... Args>
+  Node *EmplaceNode(Args &&...args) {
+    if (reclaimer_) {
+      reclaimer_->Assist();
+    }
+    stats_.OnAllocate();
+    return NewNode<Node>(resource_, std::in_place,
+                         std::forward<Args>(args)...);
+  }
+  void DestroyNode(Node *node) {
+    stats_.OnFree();
+    DeleteNode(resource_, node);
+  }
+  // node comes from a tree or handle allocating from from; when that is not
+  // our resource the value moves into a node of ours
+  Node *AdoptNode(Node *node, std::pmr::memory_resource *from) {
+    if (from == resource_) {
+      return node;
+    }
+    Node *res = EmplaceNode(std::move(node->data_));
+    stats_.OnFree();
+    DeleteNode(from, node);
+    return res;
+  }
+
+  Color ColorOf(Node *x) { return x ? x->color_ : BLACK; }
+  void SetColor(Node *x, Color clr) {
+    if (x) {
+      x->color_ = clr;
+      stats_.OnRecolor(1);
+    }
+  }
+  void DeleteFixup(Node *x, Node *parent) {
     while (x != root_ && ColorOf(x) == BLACK) {
       if (!parent) break;
 
       if (x == parent->left_) {
-        RBNode<DataType> *w = parent ? parent->right_ : nullptr;
+        Node *w = parent ? parent->right_ : nullptr;
 
         if (ColorOf(w) == RED) {
           SetColor(w, BLACK);
@@ -323,7 +852,7 @@ class RBTree {
           break;
         }
       } else {
-        RBNode<DataType> *w = parent ? parent->left_ : nullptr;
+        Node *w = parent ? parent->left_ : nullptr;
 
         if (ColorOf(w) == RED) {
           SetColor(w, BLACK);
@@ -356,9 +885,8 @@ class RBTree {
     if (root_) root_->color_ = BLACK;
   }
 
-  void ChangeConnections(RBNode<DataType> *being_deleted,
-                         RBNode<DataType> *new_el) {
-    RBNode<DataType> *p = being_deleted->parent_;
+  void ChangeConnections(Node *being_deleted, Node *new_el) {
+    Node *p = being_deleted->parent_;
     if (!p) {
       root_ = new_el;
     } else if (p->left_ == being_deleted) {
@@ -372,7 +900,7 @@ class RBTree {
     }
   }
 
-  int CntChild(RBNode<DataType> *node) {
+  int CntChild(Node *node) {
     int res = 0;
     if (node->left_) {
       res++;
@@ -383,7 +911,85 @@ class RBTree {
     return res;
   }
 
-  void CntElementsSupport(RBNode<DataType> *node, size_t *cnt) {
+  void InspectSupport(const Node *node, size_t depth, TreeShape *shape) const {
+    if (node) {
+      if (shape->depth_histogram.size() <= depth) {
+        shape->depth_histogram.resize(depth + 1);
+      }
+      ++shape->depth_histogram[depth];
+      ++shape->size;
+#if defined(__GLIBC__)
+      shape->allocated_bytes +=
+          resource_ ? sizeof(Node)
+                    : malloc_usable_size(const_cast<Node *>(node));
+#else
+      shape->allocated_bytes += sizeof(Node);
+#endif
+      InspectSupport(node->left_, depth + 1, shape);
+      InspectSupport(node->right_, depth + 1, shape);
+    }
+  }
+
+  // black height of the subtree, -1 when a rule is broken inside it
+  int ValidateSupport(const Node *node, const Node **prev, bool unique) const {
+    if (!node) {
+      return 0;
+    }
+
+    bool ok = (!node->left_ || node->left_->parent_ == node) &&
+              (!node->right_ || node->right_->parent_ == node);
+    ok = ok && (node->color_ == BLACK ||
+                ((!node->left_ || node->left_->color_ == BLACK) &&
+                 (!node->right_ || node->right_->color_ == BLACK)));
+
+    int left = ok ? ValidateSupport(node->left_, prev, unique) : -1;
+
+    if (left >= 0 && *prev) {
+      const Key &a = key_of_value((*prev)->data_);
+      const Key &b = key_of_value(node->data_);
+      ok = unique ? comp(a, b) : !comp(b, a);
+    }
+    *prev = node;
+
+    if constexpr (Augment::kEnabled &&
+                  std::equality_comparable<typename Augment::value_type>) {
+      Node copy(node->data_);
+      copy.left_ = node->left_;
+      copy.right_ = node->right_;
+      Augment::Update(&copy);
+      ok = ok && copy.aug_ == node->aug_;
+    }
+
+    int right = ok && left >= 0 ? ValidateSupport(node->right_, prev, unique)
+                                : -1;
+
+    return left >= 0 && left == right ? left + (node->color_ == BLACK) : -1;
+  }
+
+  Node *BuildSupport(const DataType *data, size_t lo, size_t hi, Node *parent,
+                     size_t depth, size_t red_depth) {
+    Node *node = nullptr;
+    if (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      node = CreateNode(data[mid]);
+      node->parent_ = parent;
+      node->color_ = depth == red_depth ? RED : BLACK;
+      // a throw frees what was built below node so far, and node
+      try {
+        node->left_ = BuildSupport(data, lo, mid, node, depth + 1, red_depth);
+        node->right_ =
+            BuildSupport(data, mid + 1, hi, node, depth + 1, red_depth);
+      } catch (...) {
+        DelSubtree(node);
+        throw;
+      }
+      Augment::Update(node);
+    }
+
+    return node;
+  }
+
+  void CntElementsSupport(Node *node, size_t *cnt) const {
     if (node) {
       (*cnt)++;
       CntElementsSupport(node->left_, cnt);
@@ -391,12 +997,12 @@ class RBTree {
     }
   }
 
-  RBNode<DataType> *CloneSubtree(RBNode<DataType> *node,
-                                 RBNode<DataType> *parent) {
-    RBNode<DataType> *copy = nullptr;
+  Node *CloneSubtree(Node *node, Node *parent) {
+    Node *copy = nullptr;
     if (node) {
-      copy = new RBNode<DataType>(node->data_);
+      copy = CreateNode(node->data_);
       copy->color_ = node->color_;
+      copy->aug_ = node->aug_;
       copy->parent_ = parent;
       copy->left_ = CloneSubtree(node->left_, copy);
       copy->right_ = CloneSubtree(node->right_, copy);
@@ -405,20 +1011,47 @@ class RBTree {
     return copy;
   }
 
-  RBNode<DataType> *SupportFindMinimum(RBNode<DataType> *root) const {
-    RBNode<DataType> *cur = root;
+  static Node *Predecessor(Node *node) {
+    if (node->left_) {
+      node = node->left_;
+      while (node->right_) {
+        node = node->right_;
+      }
+      return node;
+    }
+    while (node->parent_ && node == node->parent_->left_) {
+      node = node->parent_;
+    }
+    return node->parent_;
+  }
+
+  // free slot between two neighbours: the left of next when it has none,
+  // otherwise the right of prev, which is then the rightmost of next's left
+  static InsertPos PosBetween(Node *prev, Node *next) {
+    InsertPos pos;
+    if (next && !next->left_) {
+      pos.parent_ = next;
+      pos.left_ = true;
+    } else if (prev) {
+      pos.parent_ = prev;
+    }
+    return pos;
+  }
+
+  Node *SupportFindMinimum(Node *root) const {
+    Node *cur = root;
     while (cur->left_) {
       cur = cur->left_;
     }
     return cur;
   }
 
-  void Balance(RBNode<DataType> *node) {
-    RBNode<DataType> *dad = node->parent_;
+  void Balance(Node *node) {
+    Node *dad = node->parent_;
 
     while (dad && dad->color_ == RED) {
-      RBNode<DataType> *grand = dad->parent_;
-      RBNode<DataType> *uncle;
+      Node *grand = dad->parent_;
+      Node *uncle;
 
       if (!grand) {
         return;
@@ -429,6 +1062,7 @@ class RBTree {
           dad->color_ = BLACK;
           uncle->color_ = BLACK;
           grand->color_ = RED;
+          stats_.OnRecolor(3);
 
           node = grand;
           dad = node->parent_;
@@ -445,6 +1079,7 @@ class RBTree {
           }
           dad->color_ = BLACK;
           grand->color_ = RED;
+          stats_.OnRecolor(2);
           RightRotate(dad, grand, grand->parent_);
           break;
         }
@@ -455,6 +1090,7 @@ class RBTree {
           dad->color_ = BLACK;
           uncle->color_ = BLACK;
           grand->color_ = RED;
+          stats_.OnRecolor(3);
 
           node = grand;
           dad = node->parent_;
@@ -471,6 +1107,7 @@ class RBTree {
           }
           dad->color_ = BLACK;
           grand->color_ = RED;
+          stats_.OnRecolor(2);
           LeftRotate(dad, grand, grand->parent_);
           break;
         }
@@ -480,9 +1117,9 @@ class RBTree {
     root_->color_ = BLACK;
   }
 
-  void LeftRotate(RBNode<DataType> *child, RBNode<DataType> *dad,
-                  RBNode<DataType> *grand) {
-    RBNode<DataType> *grandson = child->left_;
+  void LeftRotate(Node *child, Node *dad, Node *grand) {
+    Node *grandson = child->left_;
+    stats_.OnRotate();
 
     dad->right_ = grandson;
     if (grandson) {
@@ -500,11 +1137,14 @@ class RBTree {
     } else {
       grand->right_ = child;
     }
+
+    Augment::Update(dad);
+    Augment::Update(child);
   }
 
-  void RightRotate(RBNode<DataType> *child, RBNode<DataType> *dad,
-                   RBNode<DataType> *grand) {
-    RBNode<DataType> *grandson = child->right_;
+  void RightRotate(Node *child, Node *dad, Node *grand) {
+    Node *grandson = child->right_;
+    stats_.OnRotate();
 
     dad->left_ = grandson;
     if (grandson) {
@@ -522,6 +1162,19 @@ class RBTree {
     } else {
       grand->left_ = child;
     }
+
+    Augment::Update(dad);
+    Augment::Update(child);
+  }
+
+  // recomputes the aggregates from node up to the root
+  void UpdatePath(Node *node) {
+    if constexpr (Augment::kEnabled) {
+      while (node) {
+        Augment::Update(node);
+        node = node->parent_;
+      }
+    }
   }
 };
 }  // namespace s21
@@ -0,0 +1,194 @@
+#ifndef RECLAIMER_H
+#define RECLAIMER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory_resource>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_set>
+
+namespace s21 {
+// how much a reclaimer frees at a time
+struct reclaim_budget {
+  size_t nodes = 4096;
+  // zero is no limit
+  std::chrono::microseconds time{0};
+};
+
+// Frees the nodes of trees that were cleared, destroyed or assigned over, so
+// that those calls only detach the old root and return in O(1) however big
+// the tree was. The detached trees are freed a slice at a time, a slice
+// ending after budget().nodes nodes or budget().time, whichever comes first:
+//
+// - in mode::background a thread of the reclaimer frees them, yielding
+//   between slices. Nodes from a memory resource are then freed on that
+//   thread, so the resource has to be safe to use from there;
+// - in mode::assist the trees attached to the reclaimer free one slice
+//   every time they allocate a node, so the old tree goes away as a new one
+//   is built, in steps no longer than a slice.
+//
+// wait() returns once everything handed over is freed, and so does the
+// destructor. A reclaimer may go away before the trees attached to it, in
+// either mode: it detaches them first, and from then on they free their
+// nodes in place. It must not be destroyed while another thread is
+// modifying one of them.
+class reclaimer {
+ public:
+  enum class mode { background, assist };
+  using budget = reclaim_budget;
+
+  // frees up to steps steps of the detached tree at *root, a step being a
+  // node freed or a rotation; *root becomes what is left, nullptr when
+  // done. Returns the number of nodes freed.
+  using SliceFn = size_t (*)(void **root, std::pmr::memory_resource *resource,
+                             size_t steps);
+
+  explicit reclaimer(mode m = mode::background, budget b = budget())
+      : mode_(m), budget_(b) {
+    if (mode_ == mode::background) {
+      worker_ = std::jthread([this](std::stop_token stop) { Work(stop); });
+    }
+  }
+  reclaimer(const reclaimer &) = delete;
+  reclaimer &operator=(const reclaimer &) = delete;
+  ~reclaimer() {
+    if (worker_.joinable()) {
+      worker_.request_stop();
+      worker_.join();
+    }
+    {
+      std::lock_guard lock(mutex_);
+      for (reclaimer **owner : owners_) {
+        *owner = nullptr;
+      }
+    }
+    while (Slice()) {
+    }
+  }
+
+  // blocks until every tree handed over so far is freed; in mode::assist
+  // the calling thread frees them
+  void wait() {
+    while (mode_ == mode::assist && Slice()) {
+    }
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+  // trees handed over and not freed yet
+  size_t pending() const { return pending_.load(std::memory_order_relaxed); }
+  // nodes freed so far
+  size_t freed() const { return freed_.load(std::memory_order_relaxed); }
+  mode get_mode() const { return mode_; }
+  budget get_budget() const { return budget_; }
+
+  // an attached tree registers where it keeps its pointer to the
+  // reclaimer, which the destructor resets
+  void Attach(reclaimer **owner) {
+    std::lock_guard lock(mutex_);
+    owners_.insert(owner);
+  }
+  void Detach(reclaimer **owner) {
+    std::lock_guard lock(mutex_);
+    owners_.erase(owner);
+  }
+
+  // takes over the detached tree at root
+  void Adopt(void *root, std::pmr::memory_resource *resource, SliceFn slice) {
+    {
+      std::lock_guard lock(mutex_);
+      jobs_.push_back({root, resource, slice});
+      ++pending_;
+    }
+    work_.notify_one();
+  }
+
+  // called by attached trees on every allocation: one slice in
+  // mode::assist, when there is anything to free
+  void Assist() {
+    if (mode_ == mode::assist && pending_.load(std::memory_order_relaxed)) {
+      Slice();
+    }
+  }
+
+ private:
+  // steps between looks at the clock
+  static constexpr size_t kChunk = 256;
+
+  struct Job {
+    void *root;
+    std::pmr::memory_resource *resource;
+    SliceFn slice;
+  };
+
+  // one slice of the oldest job, false when there is none; the job is off
+  // the queue meanwhile, so threads assisting at once free different trees
+  bool Slice() {
+    Job job;
+    {
+      std::lock_guard lock(mutex_);
+      if (jobs_.empty()) {
+        return false;
+      }
+      job = jobs_.front();
+      jobs_.pop_front();
+    }
+    auto start = std::chrono::steady_clock::now();
+    size_t freed = 0;
+    for (size_t left = budget_.nodes; job.root && left;) {
+      size_t steps = std::min(left, kChunk);
+      freed += job.slice(&job.root, job.resource, steps);
+      left -= steps;
+      if (budget_.time.count() &&
+          std::chrono::steady_clock::now() - start >= budget_.time) {
+        break;
+      }
+    }
+    freed_ += freed;
+
+    bool done = false;
+    {
+      std::lock_guard lock(mutex_);
+      if (job.root) {
+        jobs_.push_front(job);
+      } else {
+        done = --pending_ == 0;
+      }
+    }
+    if (done) {
+      done_.notify_all();
+    }
+    return true;
+  }
+
+  void Work(std::stop_token stop) {
+    std::unique_lock lock(mutex_);
+    while (work_.wait(lock, stop, [this] { return !jobs_.empty(); })) {
+      lock.unlock();
+      Slice();
+      std::this_thread::yield();
+      lock.lock();
+    }
+  }
+
+  const mode mode_;
+  const budget budget_;
+  std::mutex mutex_;
+  std::condition_variable_any work_;
+  std::condition_variable done_;
+  std::deque<Job> jobs_;
+  std::unordered_set<reclaimer **> owners_;
+  // jobs queued or in a slice right now, changed under mutex_
+  std::atomic<size_t> pending_{0};
+  std::atomic<size_t> freed_{0};
+  std::jthread worker_;
+};
+}  // namespace s21
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "vector.h"
+
+namespace s21 {
+// Growable ring of elements with a power-of-two capacity, so positions wrap
+// with a mask. Both ends push and pop in O(1) and the capacity only grows,
+// so a queue or stack of stable size stops allocating once warmed up.
+template <typename T>
+class RingBuffer {
+ public:
+  RingBuffer() = default;
+  RingBuffer(const RingBuffer &other) {
+    Reserve(other.size_);
+    for (size_t i = 0; i < other.size_; ++i) {
+      EmplaceBack(other[i]);
+    }
+  }
+  RingBuffer(RingBuffer &&other) noexcept { Swap(other); }
+  ~RingBuffer() {
+    Clear();
+    std::allocator<T>().deallocate(data_, Capacity());
+  }
+
+  RingBuffer &operator=(RingBuffer other) noexcept {
+    Swap(other);
+    return *this;
+  }
+
+  size_t Size() const { return size_; }
+  size_t Capacity() const { return data_ ? mask_ + 1 : 0; }
+
+  T &operator[](size_t i) { return data_[(head_ + i) & mask_]; }
+  const T &operator[](size_t i) const { return data_[(head_ + i) & mask_]; }
+  T &Front() { return data_[head_]; }
+  const T &Front() const { return data_[head_]; }
+  T &Back() { return (*this)[size_ - 1]; }
+  const T &Back() const { return (*this)[size_ - 1]; }
+
+  template <typename... Args>
+  T &EmplaceBack(Args &&...args) {
+    if (size_ == Capacity()) {
+      // built first, args may refer to an element of the old buffer
+      T value(std::forward<Args>(args)...);
+      Reserve(size_ + 1);
+      return *::new (static_cast<void *>(&(*this)[size_++]))
+          T(std::move(value));
+    }
+    return *::new (static_cast<void *>(&(*this)[size_++]))
+        T(std::forward<Args>(args)...);
+  }
+  void PopFront() {
+    std::destroy_at(data_ + head_);
+    head_ = (head_ + 1) & mask_;
+    --size_;
+  }
+  void PopBack() {
+    std::destroy_at(&Back());
+    --size_;
+  }
+  void Clear() {
+    while (size_) {
+      PopBack();
+    }
+    head_ = 0;
+  }
+
+  // grows to the next power of two that holds n elements
+  void Reserve(size_t n) {
+    if (n <= Capacity()) {
+      return;
+    }
+    size_t capacity = std::max<size_t>(Capacity() * 2, 8);
+    while (capacity < n) {
+      capacity *= 2;
+    }
+    T *fresh = std::allocator<T>().allocate(capacity);
+    // the wrapped part goes right after the first one, in order
+    size_t first = std::min(size_, Capacity() - head_);
+    Relocate(data_ + head_, first, fresh);
+    Relocate(data_, size_ - first, fresh + first);
+    std::allocator<T>().deallocate(data_, Capacity());
+    data_ = fresh;
+    mask_ = capacity - 1;
+    head_ = 0;
+  }
+
+  void Swap(RingBuffer &other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(mask_, other.mask_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+ private:
+  static void Relocate(T *from, size_t n, T *to) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+      if (n) {
+        std::memcpy(static_cast<void *>(to), static_cast<void *>(from),
+                    n * sizeof(T));
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        ::new (static_cast<void *>(to + i)) T(std::move_if_noexcept(from[i]));
+      }
+      std::destroy_n(from, n);
+    }
+  }
+
+  T *data_ = nullptr;
+  size_t mask_ = 0;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+}  // namespace s21
+
+#endif
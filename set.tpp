@@ -10,13 +10,13 @@ set<T, Compare>::set(std::initializer_list<value_type> const &items) {
 }
 
 template <typename T, typename Compare>
-bool set<T, Compare>::empty() {
+bool set<T, Compare>::empty() const {
   bool res = this->root_ == nullptr ? true : false;
   return res;
 }
 
 template <typename T, typename Compare>
-typename set<T, Compare>::size_type set<T, Compare>::max_size() {
+typename set<T, Compare>::size_type set<T, Compare>::max_size() const {
   using node_t = s21::RBNode<T>;
   return std::numeric_limits<size_type>::max() / sizeof(node_t);
 }
@@ -43,11 +43,33 @@ std::pair<typename set<T, Compare>::iterator, bool> set<T, Compare>::insert(
   return res;
 }
 
+template <typename T, typename Compare>
+typename set<T, Compare>::insert_return_type set<T, Compare>::insert(
+    node_type &&nh) {
+  insert_return_type res{end(), false, node_type()};
+
+  if (!nh.empty()) {
+    auto pos = this->FindUniquePos(this->key_of_value(nh.value()));
+    if (pos.found_) {
+      res.position = iterator(pos.found_, this);
+      res.node = std::move(nh);
+    } else {
+      Node *node = this->AdoptNode(nh.Release(), nh.resource());
+      this->LinkNode(node, pos);
+      res.position = iterator(node, this);
+      res.inserted = true;
+    }
+  }
+
+  return res;
+}
+
 template <typename T, typename Compare>
 template <typename... Args>
-std::vector<std::pair<typename set<T, Compare>::iterator, bool>>
+s21::vector<std::pair<typename set<T, Compare>::iterator, bool>,
+            sizeof...(Args)>
 set<T, Compare>::insert_many(Args &&...args) {
-  std::vector<std::pair<iterator, bool>> results;
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
 
   for (auto value : std::initializer_list<value_type>{args...}) {
     results.push_back(insert(value));
@@ -61,6 +83,7 @@ void set<T, Compare>::swap(set &other) {
   auto tmp_root = this->root_;
   this->root_ = other.root_;
   other.root_ = tmp_root;
+  std::swap(this->resource_, other.resource_);
 
   auto tmp_comp = this->comp;
   this->comp = other.comp;
@@ -73,27 +96,112 @@ void set<T, Compare>::swap(set &other) {
 
 template <typename T, typename Compare>
 void set<T, Compare>::merge(set &other) {
-  iterator it = other.begin();
-  iterator next = it;
-  while (it != other.end()) {
-    next = it;
-    ++next;
-    if (insert(std::move(*it)).second) {
-      other.erase(it);
+  if (this != &other) {
+    iterator it = other.begin();
+    iterator next = it;
+    while (it != other.end()) {
+      next = it;
+      ++next;
+      // the position stays valid while the node is unlinked from other
+      auto pos = this->FindUniquePos(*it);
+      if (!pos.found_) {
+        this->LinkNode(
+            this->AdoptNode(other.ExtractNode(it.node_), other.resource_),
+            pos);
+      }
+      it = next;
     }
-    it = next;
   }
 }
 
 template <typename T, typename Compare>
-typename set<T, Compare>::iterator set<T, Compare>::find(const key_type &key) {
-  iterator res;
-  res.node_ = this->Search(key);
+std::vector<typename set<T, Compare>::const_iterator>
+set<T, Compare>::lookup_many(std::span<const key_type> keys,
+                             size_type width) const {
+  std::vector<const_iterator> res(keys.size(), end());
+  this->LowerBoundMany(keys, width, [&](size_t i, Node *node) {
+    if (node && !this->Less(keys[i], node->data_)) {
+      res[i].node_ = node;
+    }
+  });
   return res;
 }
 
 template <typename T, typename Compare>
-bool set<T, Compare>::contains(const key_type &key) {
+typename set<T, Compare>::iterator set<T, Compare>::find(const key_type &key) {
+  return iterator(this->Search(key), this);
+}
+
+template <typename T, typename Compare>
+bool set<T, Compare>::contains(const key_type &key) const {
   bool res = this->Search(key) == nullptr ? false : true;
   return res;
-}
\ No newline at end of file
+}
+template <typename T, typename Compare>
+void set<T, Compare>::serialize(std::ostream &os) const {
+  SortedFileWriter<T> writer(os, false);
+  this->ForEach([&writer](const T &key) { writer.Add(key); });
+  writer.Finish();
+}
+
+template <typename T, typename Compare>
+void set<T, Compare>::serialize(int fd) const {
+  SortedFileWriter<T> writer(fd, false);
+  this->ForEach([&writer](const T &key) { writer.Add(key); });
+  writer.Finish();
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set<T, Compare>::deserialize(std::istream &is) {
+  SortedFileReader<T> reader(is);
+  return Load(reader);
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set<T, Compare>::deserialize(int fd) {
+  SortedFileReader<T> reader(fd);
+  return Load(reader);
+}
+
+// the keys arrive sorted, so the tree is built in O(n) without descents
+template <typename T, typename Compare>
+set<T, Compare> set<T, Compare>::Load(SortedFileReader<T> &reader) {
+  const size_t chunk = 1 << 16;
+  std::vector<T> keys;
+  size_t got = chunk;
+  while (got == chunk) {
+    size_t old = keys.size();
+    keys.resize(old + chunk);
+    got = reader.Read(keys.data() + old, chunk);
+    keys.resize(old + got);
+  }
+  reader.Verify();
+
+  set res;
+  if (!res.IsSorted(keys.data(), keys.size())) {
+    throw std::runtime_error("sorted file: keys are not strictly ordered");
+  }
+  res.BuildFromSorted(keys.data(), keys.size());
+
+  return res;
+}
+
+template <typename T, typename Compare>
+set<T, Compare> set<T, Compare>::from_sorted(const T *keys, size_type n) {
+  set res;
+  if (!res.IsSorted(keys, n)) {
+    throw std::invalid_argument("set: keys are not strictly ordered");
+  }
+  res.BuildFromSorted(keys, n);
+  return res;
+}
+
+template <typename T, typename Compare>
+bool set<T, Compare>::IsSorted(const T *keys, size_type n) const {
+  for (size_type i = 1; i < n; ++i) {
+    if (!this->comp(keys[i - 1], keys[i])) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,212 @@
+#ifndef SET_VIEWS_H
+#define SET_VIEWS_H
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+namespace s21 {
+// Lazy views over sorted containers (set, multiset), const or not: nothing
+// is copied, the views walk the iterators of the containers they refer to,
+// so those must outlive the view and stay unmodified while it is iterated.
+// Both operands of a set-algebra view have to be ordered by the same
+// comparison, the one of the first.
+
+// the keys of c in [first, last), found with two lower_bound descents
+template <typename Container, typename K>
+std::ranges::subrange<decltype(std::declval<Container &>().begin())> range(
+    Container &c, const K &first, const K &last) {
+  if (!c.key_comp()(first, last)) {
+    return {c.end(), c.end()};
+  }
+  return {c.lower_bound(first), c.lower_bound(last)};
+}
+
+enum class SetOp { kUnion, kIntersection, kDifference };
+
+// Merges the two ordered sequences on the fly. The results follow
+// std::set_union, std::set_intersection and std::set_difference, so with
+// multisets a key shows up max(m, n), min(m, n) and m - n times.
+template <SetOp Op, typename A, typename B>
+class SetOpIterator {
+ public:
+  using iterator_concept = std::forward_iterator_tag;
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = typename A::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type *;
+  using reference = const value_type &;
+
+  SetOpIterator() = default;
+  SetOpIterator(A *a, B *b)
+      : a_(a),
+        b_(b),
+        ia_(a->begin()),
+        ea_(a->end()),
+        ib_(b->begin()),
+        eb_(b->end()),
+        comp_(a->key_comp()) {
+    Settle();
+  }
+
+  reference operator*() const {
+    if constexpr (Op == SetOp::kUnion) {
+      if (ia_ == ea_ || (ib_ != eb_ && comp_(*ib_, *ia_))) {
+        return *ib_;
+      }
+    }
+    return *ia_;
+  }
+  pointer operator->() const { return &**this; }
+
+  SetOpIterator &operator++() {
+    if constexpr (Op == SetOp::kUnion) {
+      if (ia_ == ea_) {
+        ++ib_;
+      } else if (ib_ == eb_ || comp_(*ia_, *ib_)) {
+        ++ia_;
+      } else if (comp_(*ib_, *ia_)) {
+        ++ib_;
+      } else {
+        ++ia_;
+        ++ib_;
+      }
+    } else if constexpr (Op == SetOp::kIntersection) {
+      ++ia_;
+      ++ib_;
+    } else {
+      ++ia_;
+    }
+    Settle();
+    return *this;
+  }
+  SetOpIterator operator++(int) {
+    SetOpIterator res = *this;
+    ++*this;
+    return res;
+  }
+
+  bool operator==(const SetOpIterator &other) const {
+    return ia_ == other.ia_ && ib_ == other.ib_;
+  }
+  bool operator==(std::default_sentinel_t) const {
+    if constexpr (Op == SetOp::kUnion) {
+      return ia_ == ea_ && ib_ == eb_;
+    } else if constexpr (Op == SetOp::kIntersection) {
+      return ia_ == ea_ || ib_ == eb_;
+    } else {
+      return ia_ == ea_;
+    }
+  }
+
+ private:
+  // const_iterator when the container is const
+  using IterA = decltype(std::declval<A &>().begin());
+  using IterB = decltype(std::declval<B &>().begin());
+
+  // steps taken one by one before a skip falls back to lower_bound: operands
+  // of similar size merge linearly, while a small one against a large one
+  // costs a descent per key instead of a walk over every gap
+  static constexpr int kLinearSteps = 8;
+
+  // moves it, an iterator of c, to the first key not less than key
+  template <typename C, typename It>
+  void Seek(C *c, It &it, const It &end, const value_type &key) {
+    for (int i = 0; i < kLinearSteps; ++i) {
+      if (it == end || !comp_(*it, key)) {
+        return;
+      }
+      ++it;
+    }
+    if (it != end && comp_(*it, key)) {
+      it = c->lower_bound(key);
+    }
+  }
+
+  // moves on to the next key the view yields
+  void Settle() {
+    if constexpr (Op == SetOp::kIntersection) {
+      while (ia_ != ea_ && ib_ != eb_) {
+        if (comp_(*ia_, *ib_)) {
+          Seek(a_, ia_, ea_, *ib_);
+        } else if (comp_(*ib_, *ia_)) {
+          Seek(b_, ib_, eb_, *ia_);
+        } else {
+          return;
+        }
+      }
+    } else if constexpr (Op == SetOp::kDifference) {
+      while (ia_ != ea_ && ib_ != eb_) {
+        if (comp_(*ia_, *ib_)) {
+          return;
+        } else if (comp_(*ib_, *ia_)) {
+          Seek(b_, ib_, eb_, *ia_);
+        } else {
+          ++ia_;
+          ++ib_;
+        }
+      }
+    }
+  }
+
+  A *a_ = nullptr;
+  B *b_ = nullptr;
+  IterA ia_{};
+  IterA ea_{};
+  IterB ib_{};
+  IterB eb_{};
+  typename A::key_compare comp_{};
+};
+
+template <typename View, SetOp Op, typename A, typename B>
+class SetOpView : public std::ranges::view_interface<View> {
+ public:
+  using iterator = SetOpIterator<Op, A, B>;
+
+  SetOpView() = default;
+  SetOpView(A &a, B &b) : a_(&a), b_(&b) {}
+
+  iterator begin() const { return iterator(a_, b_); }
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+ private:
+  A *a_ = nullptr;
+  B *b_ = nullptr;
+};
+
+// keys in a or b
+template <typename A, typename B>
+class union_view
+    : public SetOpView<union_view<A, B>, SetOp::kUnion, A, B> {
+ public:
+  using SetOpView<union_view<A, B>, SetOp::kUnion, A, B>::SetOpView;
+};
+template <typename A, typename B>
+union_view(A &, B &) -> union_view<A, B>;
+
+// keys in both a and b; whichever side is behind skips ahead, through
+// lower_bound once a gap is longer than a few keys
+template <typename A, typename B>
+class intersection_view
+    : public SetOpView<intersection_view<A, B>, SetOp::kIntersection, A, B> {
+ public:
+  using SetOpView<intersection_view<A, B>, SetOp::kIntersection, A,
+                  B>::SetOpView;
+};
+template <typename A, typename B>
+intersection_view(A &, B &) -> intersection_view<A, B>;
+
+// keys in a but not in b
+template <typename A, typename B>
+class difference_view
+    : public SetOpView<difference_view<A, B>, SetOp::kDifference, A, B> {
+ public:
+  using SetOpView<difference_view<A, B>, SetOp::kDifference, A,
+                  B>::SetOpView;
+};
+template <typename A, typename B>
+difference_view(A &, B &) -> difference_view<A, B>;
+}  // namespace s21
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef SHARDED_SET_H
+#define SHARDED_SET_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "set.h"
+
+namespace s21 {
+// Ordered set split by key range over Shards trees, each behind its own
+// lock, so writers to different ranges do not wait for each other.
+//
+// The ranges are cut at split points: shard i holds the keys from
+// splits()[i - 1] up to, but not including, splits()[i]. Every shard keeps
+// a small reservoir sample of the keys inserted into it, and once a shard
+// has grown to twice the average size, rebalance picks new split points at
+// the quantiles of the samples, weighted by shard size, and moves the keys
+// that changed shards over as nodes. A bulk insert into an empty set takes
+// its split points from a sample of the batch instead.
+//
+// insert, erase, contains, count, insert_bulk, rebalance, size and clear
+// may be called from any number of threads at once. Iterators and
+// lower_bound read the shards without locks and, as with the other
+// containers, stay valid only while nobody modifies the set.
+template <typename Key, size_t Shards, typename Compare = std::less<Key>>
+class sharded_set {
+  static_assert(Shards > 0, "sharded_set needs at least one shard");
+
+ public:
+  using set_type = set<Key, Compare>;
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+  // walks the shards in order, and so all keys in order
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    const_iterator() = default;
+
+    reference operator*() const { return *it_; }
+    pointer operator->() const { return &*it_; }
+
+    const_iterator &operator++() {
+      ++it_;
+      Settle();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator res = *this;
+      ++*this;
+      return res;
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return shard_ == other.shard_ && it_ == other.it_;
+    }
+
+   private:
+    friend class sharded_set;
+
+    const_iterator(const sharded_set *owner, size_t shard,
+                   typename set_type::const_iterator it)
+        : owner_(owner), shard_(shard), it_(it) {
+      Settle();
+    }
+
+    // moves past the ends of shards, to the end of the last one at most
+    void Settle() {
+      while (shard_ < Shards && it_ == owner_->shards_[shard_].keys.end()) {
+        if (++shard_ < Shards) {
+          it_ = owner_->shards_[shard_].keys.begin();
+        } else {
+          it_ = typename set_type::const_iterator();
+        }
+      }
+    }
+
+    const sharded_set *owner_ = nullptr;
+    size_t shard_ = Shards;
+    typename set_type::const_iterator it_;
+  };
+  using iterator = const_iterator;
+
+  sharded_set() = default;
+  sharded_set(std::initializer_list<value_type> const &items);
+  // the shards hold locks, a sharded set stays where it was built
+  sharded_set(const sharded_set &) = delete;
+  sharded_set &operator=(const sharded_set &) = delete;
+
+  const_iterator begin() const {
+    return const_iterator(this, 0, shards_[0].keys.begin());
+  }
+  const_iterator end() const {
+    return const_iterator(this, Shards, typename set_type::const_iterator());
+  }
+
+  bool empty() const { return size() == 0; }
+  size_type size() const;
+
+  void clear();
+  bool insert(const value_type &value);
+  // inserts keys with up to threads threads, one shard per thread at a
+  // time; returns how many keys were new
+  size_type insert_bulk(std::span<const value_type> keys,
+                        size_type threads = 0);
+  size_type erase(const key_type &key);
+
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const { return contains(key); }
+  const_iterator lower_bound(const key_type &key) const;
+  key_compare key_comp() const { return comp_; }
+
+  // recomputes the split points from the samples and moves keys over
+  void rebalance();
+  std::vector<key_type> splits() const;
+  std::array<size_type, Shards> shard_sizes() const;
+
+  bool validate() const;
+
+ private:
+  // keys sampled per shard, and per shard from a bulk insert into an empty
+  // set
+  static constexpr size_t kSampleSize = 64;
+  // shards smaller than this are never worth a rebalance
+  static constexpr size_t kMinRebalance = 1024;
+
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    set_type keys;
+    std::atomic<size_t> size{0};
+    // reservoir of keys inserted so far, seen counts them
+    std::vector<Key> sample;
+    size_t seen = 0;
+    std::minstd_rand gen;
+  };
+
+  size_t ShardOf(const key_type &key) const;
+  // counts and samples value, just inserted into shard i under its lock;
+  // returns the new size of the shard
+  size_t Added(size_t i, const value_type &value);
+  // rebalances once a shard grown to n keys holds twice the average
+  void MaybeRebalance(size_t n);
+  bool Unbalanced(size_t n) const;
+  // new split points and the keys moved to match, route_mutex_ held
+  void Resplit();
+  // split points at the quantiles of keys weighted by how many keys of the
+  // set each one stands for
+  std::vector<key_type> Cut(
+      std::vector<std::pair<key_type, double>> weighted) const;
+
+  std::array<Shard, Shards> shards_;
+  std::vector<key_type> splits_;
+  // shared by every operation, held exclusively while splits_ change
+  mutable std::shared_mutex route_mutex_;
+  [[no_unique_address]] Compare comp_;
+};
+}  // namespace s21
+
+#include "sharded_set.tpp"
+
+#endif
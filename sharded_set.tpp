@@ -0,0 +1,309 @@
+#include <algorithm>
+
+#include "sharded_set.h"
+
+template <typename Key, size_t Shards, typename Compare>
+s21::sharded_set<Key, Shards, Compare>::sharded_set(
+    std::initializer_list<value_type> const &items) {
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, size_t Shards, typename Compare>
+typename s21::sharded_set<Key, Shards, Compare>::size_type
+s21::sharded_set<Key, Shards, Compare>::size() const {
+  size_type res = 0;
+  for (const Shard &shard : shards_) {
+    res += shard.size.load(std::memory_order_relaxed);
+  }
+  return res;
+}
+
+template <typename Key, size_t Shards, typename Compare>
+void s21::sharded_set<Key, Shards, Compare>::clear() {
+  std::unique_lock route(route_mutex_);
+  for (Shard &shard : shards_) {
+    shard.keys.clear();
+    shard.size = 0;
+    shard.sample.clear();
+    shard.seen = 0;
+  }
+  splits_.clear();
+}
+
+template <typename Key, size_t Shards, typename Compare>
+bool s21::sharded_set<Key, Shards, Compare>::insert(const value_type &value) {
+  size_t n = 0;
+  {
+    std::shared_lock route(route_mutex_);
+    size_t i = ShardOf(value);
+    std::unique_lock lock(shards_[i].mutex);
+    if (!shards_[i].keys.insert(value).second) {
+      return false;
+    }
+    n = Added(i, value);
+  }
+  // a shard is only checked every kMinRebalance keys it grows by, so the
+  // sizes of all shards are summed once per that many inserts
+  if (n % kMinRebalance == 0) {
+    MaybeRebalance(n);
+  }
+  return true;
+}
+
+template <typename Key, size_t Shards, typename Compare>
+typename s21::sharded_set<Key, Shards, Compare>::size_type
+s21::sharded_set<Key, Shards, Compare>::insert_bulk(
+    std::span<const value_type> keys, size_type threads) {
+  if (keys.empty()) {
+    return 0;
+  }
+  if (empty()) {
+    // nothing to route by yet: the batch is cut at a sample of itself
+    std::vector<std::pair<key_type, double>> weighted;
+    std::vector<key_type> sample;
+    std::sample(keys.begin(), keys.end(), std::back_inserter(sample),
+                kSampleSize * Shards, std::minstd_rand());
+    for (auto &key : sample) {
+      weighted.emplace_back(std::move(key), 1.0);
+    }
+    std::unique_lock route(route_mutex_);
+    if (empty()) {
+      splits_ = Cut(std::move(weighted));
+    }
+  }
+
+  std::atomic<size_type> inserted{0};
+  size_t largest = 0;
+  {
+    std::shared_lock route(route_mutex_);
+    std::vector<std::vector<const value_type *>> batches(Shards);
+    for (const auto &key : keys) {
+      batches[ShardOf(key)].push_back(&key);
+    }
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+      size_type cnt = 0;
+      for (size_t i = next++; i < Shards; i = next++) {
+        std::unique_lock lock(shards_[i].mutex);
+        for (const value_type *key : batches[i]) {
+          if (shards_[i].keys.insert(*key).second) {
+            Added(i, *key);
+            ++cnt;
+          }
+        }
+      }
+      inserted += cnt;
+    };
+    if (!threads) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<std::jthread> pool;
+    for (size_t t = 1; t < std::min(threads, Shards); ++t) {
+      pool.emplace_back(work);
+    }
+    work();
+    pool.clear();
+    for (const Shard &shard : shards_) {
+      largest = std::max(largest, shard.size.load(std::memory_order_relaxed));
+    }
+  }
+  MaybeRebalance(largest);
+  return inserted;
+}
+
+template <typename Key, size_t Shards, typename Compare>
+typename s21::sharded_set<Key, Shards, Compare>::size_type
+s21::sharded_set<Key, Shards, Compare>::erase(const key_type &key) {
+  std::shared_lock route(route_mutex_);
+  Shard &shard = shards_[ShardOf(key)];
+  std::unique_lock lock(shard.mutex);
+  auto it = shard.keys.find(key);
+  if (it == shard.keys.end()) {
+    return 0;
+  }
+  shard.keys.erase(it);
+  --shard.size;
+  return 1;
+}
+
+template <typename Key, size_t Shards, typename Compare>
+bool s21::sharded_set<Key, Shards, Compare>::contains(
+    const key_type &key) const {
+  std::shared_lock route(route_mutex_);
+  const Shard &shard = shards_[ShardOf(key)];
+  std::shared_lock lock(shard.mutex);
+  return shard.keys.contains(key);
+}
+
+template <typename Key, size_t Shards, typename Compare>
+typename s21::sharded_set<Key, Shards, Compare>::const_iterator
+s21::sharded_set<Key, Shards, Compare>::lower_bound(
+    const key_type &key) const {
+  size_t i = ShardOf(key);
+  return const_iterator(this, i, shards_[i].keys.lower_bound(key));
+}
+
+template <typename Key, size_t Shards, typename Compare>
+void s21::sharded_set<Key, Shards, Compare>::rebalance() {
+  std::unique_lock route(route_mutex_);
+  Resplit();
+}
+
+template <typename Key, size_t Shards, typename Compare>
+std::vector<Key> s21::sharded_set<Key, Shards, Compare>::splits() const {
+  std::shared_lock route(route_mutex_);
+  return splits_;
+}
+
+template <typename Key, size_t Shards, typename Compare>
+std::array<size_t, Shards>
+s21::sharded_set<Key, Shards, Compare>::shard_sizes() const {
+  std::array<size_type, Shards> res;
+  for (size_t i = 0; i < Shards; ++i) {
+    res[i] = shards_[i].size.load(std::memory_order_relaxed);
+  }
+  return res;
+}
+
+// every shard is a valid tree of the size it reports, holding only keys of
+// its own range
+template <typename Key, size_t Shards, typename Compare>
+bool s21::sharded_set<Key, Shards, Compare>::validate() const {
+  std::unique_lock route(route_mutex_);
+  for (size_t i = 0; i < Shards; ++i) {
+    const set_type &keys = shards_[i].keys;
+    if (keys.size() != shards_[i].size || !keys.validate()) {
+      return false;
+    }
+    if (!keys.empty() && (ShardOf(*keys.begin()) != i ||
+                          ShardOf(*std::prev(keys.end())) != i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Key, size_t Shards, typename Compare>
+size_t s21::sharded_set<Key, Shards, Compare>::ShardOf(
+    const key_type &key) const {
+  return std::upper_bound(splits_.begin(), splits_.end(), key, comp_) -
+         splits_.begin();
+}
+
+// reservoir sampling: every key inserted so far had the same chance to end
+// up in the sample
+template <typename Key, size_t Shards, typename Compare>
+size_t s21::sharded_set<Key, Shards, Compare>::Added(size_t i,
+                                                     const value_type &value) {
+  Shard &shard = shards_[i];
+  if (shard.sample.size() < kSampleSize) {
+    shard.sample.push_back(value);
+  } else if (size_t j = shard.gen() % (shard.seen + 1); j < kSampleSize) {
+    shard.sample[j] = value;
+  }
+  ++shard.seen;
+  return ++shard.size;
+}
+
+template <typename Key, size_t Shards, typename Compare>
+void s21::sharded_set<Key, Shards, Compare>::MaybeRebalance(size_t n) {
+  if (Unbalanced(n)) {
+    std::unique_lock route(route_mutex_);
+    size_t largest = 0;
+    for (const Shard &shard : shards_) {
+      largest = std::max(largest, shard.size.load(std::memory_order_relaxed));
+    }
+    // another thread may have rebalanced in the meantime
+    if (Unbalanced(largest)) {
+      Resplit();
+    }
+  }
+}
+
+template <typename Key, size_t Shards, typename Compare>
+bool s21::sharded_set<Key, Shards, Compare>::Unbalanced(size_t n) const {
+  return n >= kMinRebalance && n * Shards > 2 * size();
+}
+
+// Nodes move between shards as node handles, without reallocation. A shard
+// only loses a prefix and a suffix of its keys: a prefix moved to a shard
+// before it lands in that shard's range, which is done, and a suffix moved
+// to a later shard is in that shard's range when its turn comes.
+template <typename Key, size_t Shards, typename Compare>
+void s21::sharded_set<Key, Shards, Compare>::Resplit() {
+  std::vector<std::pair<key_type, double>> weighted;
+  for (Shard &shard : shards_) {
+    double weight = static_cast<double>(shard.size) / shard.sample.size();
+    for (auto &key : shard.sample) {
+      weighted.emplace_back(std::move(key), weight);
+    }
+    shard.sample.clear();
+  }
+  if (weighted.empty()) {
+    return;
+  }
+  splits_ = Cut(weighted);
+
+  for (size_t i = 0; i < Shards; ++i) {
+    set_type &keys = shards_[i].keys;
+    while (!keys.empty()) {
+      auto it = keys.begin();
+      size_t to = ShardOf(*it);
+      if (to >= i) {
+        break;
+      }
+      shards_[to].keys.insert(keys.extract(it));
+      --shards_[i].size;
+      ++shards_[to].size;
+    }
+    while (!keys.empty()) {
+      auto it = std::prev(keys.end());
+      size_t to = ShardOf(*it);
+      if (to <= i) {
+        break;
+      }
+      shards_[to].keys.insert(keys.extract(it));
+      --shards_[i].size;
+      ++shards_[to].size;
+    }
+  }
+
+  // the old samples go to the shards that own them now; erased keys may be
+  // among them, they only blur the next cut a little
+  for (auto &[key, weight] : weighted) {
+    Shard &shard = shards_[ShardOf(key)];
+    if (shard.sample.size() < kSampleSize) {
+      shard.sample.push_back(std::move(key));
+    }
+  }
+  for (Shard &shard : shards_) {
+    shard.seen = shard.size;
+  }
+}
+
+template <typename Key, size_t Shards, typename Compare>
+std::vector<Key> s21::sharded_set<Key, Shards, Compare>::Cut(
+    std::vector<std::pair<key_type, double>> weighted) const {
+  std::sort(weighted.begin(), weighted.end(),
+            [&](const auto &a, const auto &b) {
+              return comp_(a.first, b.first);
+            });
+  double total = 0;
+  for (const auto &entry : weighted) {
+    total += entry.second;
+  }
+  std::vector<key_type> res;
+  double acc = 0;
+  for (const auto &[key, weight] : weighted) {
+    acc += weight;
+    while (res.size() + 1 < Shards && acc * Shards > total * (res.size() + 1)) {
+      res.push_back(key);
+    }
+  }
+  while (!weighted.empty() && res.size() + 1 < Shards) {
+    res.push_back(weighted.back().first);
+  }
+  return res;
+}
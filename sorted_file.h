@@ -0,0 +1,117 @@
+#ifndef SORTED_FILE_H
+#define SORTED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace s21 {
+// On-disk layout shared by set::serialize, mapped_set and the external
+// sorter: one page with the header, then count keys in ascending order as
+// raw native bytes starting at data_offset_, so the array can be mapped and
+// searched in place.
+constexpr size_t kSortedFilePage = 4096;
+constexpr uint32_t kSortedFileVersion = 1;
+constexpr uint32_t kSortedFileMulti = 1;
+
+struct SortedFileHeader {
+  char magic_[8] = {'S', '2', '1', 'S', 'O', 'R', 'T', '\0'};
+  uint32_t version_ = kSortedFileVersion;
+  // detects files written on a machine with another byte order
+  uint32_t byte_order_ = 0x01020304;
+  uint32_t key_size_ = 0;
+  uint32_t flags_ = 0;
+  uint64_t count_ = 0;
+  uint64_t checksum_ = 0;
+  uint64_t data_offset_ = kSortedFilePage;
+
+  // throws std::runtime_error when the header does not describe Key, or
+  // puts the keys where a Key can not be read in place
+  void Check(uint32_t key_size, size_t key_align) const;
+};
+
+// 64-bit checksum over the key bytes, fed in pieces of any size
+class SortedFileChecksum {
+ public:
+  void Update(const void *data, size_t len);
+  uint64_t Value() const;
+
+ private:
+  void Mix(uint64_t word) {
+    state_ = (state_ ^ word) * 0x100000001b3ULL;
+    state_ ^= state_ >> 29;
+  }
+
+  uint64_t state_ = 0xcbf29ce484222325ULL;
+  uint64_t length_ = 0;
+  unsigned char tail_[8] = {};
+  size_t tail_len_ = 0;
+};
+
+// Streams keys into a stream or a file descriptor. The header is written
+// first as a placeholder and patched by Finish, so the target has to be
+// seekable. Throws std::runtime_error on I/O errors.
+template <typename Key>
+class SortedFileWriter {
+  static_assert(std::is_trivially_copyable_v<Key>,
+                "sorted files store keys as raw bytes");
+
+ public:
+  SortedFileWriter(std::ostream &os, bool multi);
+  SortedFileWriter(int fd, bool multi);
+  SortedFileWriter(const SortedFileWriter &) = delete;
+  SortedFileWriter &operator=(const SortedFileWriter &) = delete;
+
+  void Add(const Key &key);
+  uint64_t Count() const { return header_.count_; }
+  void Finish();
+
+ private:
+  static constexpr size_t kBufferKeys = 1 << 14;
+
+  void Flush();
+  void Write(const void *data, size_t len);
+  void WriteAt(int64_t pos, const void *data, size_t len);
+
+  std::ostream *os_ = nullptr;
+  int fd_ = -1;
+  int64_t start_ = 0;
+  SortedFileHeader header_;
+  SortedFileChecksum checksum_;
+  std::vector<Key> buffer_;
+};
+
+// Reads the keys back in order from a stream or a file descriptor.
+template <typename Key>
+class SortedFileReader {
+  static_assert(std::is_trivially_copyable_v<Key>,
+                "sorted files store keys as raw bytes");
+
+ public:
+  explicit SortedFileReader(std::istream &is);
+  explicit SortedFileReader(int fd);
+
+  const SortedFileHeader &Header() const { return header_; }
+  // reads up to n keys, returns how many were read
+  size_t Read(Key *out, size_t n);
+  // throws std::runtime_error unless every key was read and matches the
+  // checksum of the header
+  void Verify() const;
+
+ private:
+  void ReadExact(void *data, size_t len);
+
+  std::istream *is_ = nullptr;
+  int fd_ = -1;
+  SortedFileHeader header_;
+  SortedFileChecksum checksum_;
+  uint64_t read_ = 0;
+};
+}  // namespace s21
+
+#include "sorted_file.tpp"
+
+#endif
@@ -0,0 +1,224 @@
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "sorted_file.h"
+
+inline void s21::SortedFileHeader::Check(uint32_t key_size,
+                                         size_t key_align) const {
+  SortedFileHeader expected;
+  if (std::memcmp(magic_, expected.magic_, sizeof(magic_)) != 0) {
+    throw std::runtime_error("sorted file: bad magic");
+  }
+  if (version_ != kSortedFileVersion) {
+    throw std::runtime_error("sorted file: unsupported version");
+  }
+  if (byte_order_ != expected.byte_order_) {
+    throw std::runtime_error("sorted file: foreign byte order");
+  }
+  if (key_size_ != key_size) {
+    throw std::runtime_error("sorted file: key size mismatch");
+  }
+  if (data_offset_ < sizeof(SortedFileHeader) ||
+      data_offset_ > 16 * kSortedFilePage) {
+    throw std::runtime_error("sorted file: bad data offset");
+  }
+  // mapped_set reads the keys straight from the mapping
+  if (data_offset_ % key_align != 0) {
+    throw std::runtime_error("sorted file: misaligned data offset");
+  }
+}
+
+inline void s21::SortedFileChecksum::Update(const void *data, size_t len) {
+  const unsigned char *p = static_cast<const unsigned char *>(data);
+  length_ += len;
+
+  while (len && tail_len_) {
+    tail_[tail_len_++] = *p++;
+    --len;
+    if (tail_len_ == sizeof(tail_)) {
+      uint64_t word;
+      std::memcpy(&word, tail_, sizeof(word));
+      Mix(word);
+      tail_len_ = 0;
+    }
+  }
+  for (; len >= sizeof(uint64_t); p += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    Mix(word);
+    len -= sizeof(uint64_t);
+  }
+  while (len) {
+    tail_[tail_len_++] = *p++;
+    --len;
+  }
+}
+
+inline uint64_t s21::SortedFileChecksum::Value() const {
+  SortedFileChecksum res = *this;
+  if (res.tail_len_) {
+    uint64_t word = 0;
+    std::memcpy(&word, res.tail_, res.tail_len_);
+    res.Mix(word);
+  }
+  res.Mix(length_);
+  return res.state_;
+}
+
+template <typename Key>
+s21::SortedFileWriter<Key>::SortedFileWriter(std::ostream &os, bool multi)
+    : os_(&os) {
+  start_ = static_cast<int64_t>(os.tellp());
+  if (start_ < 0) {
+    throw std::runtime_error("sorted file: stream is not seekable");
+  }
+  header_.key_size_ = sizeof(Key);
+  header_.flags_ = multi ? kSortedFileMulti : 0;
+  std::vector<char> page(kSortedFilePage);
+  Write(page.data(), page.size());
+  buffer_.reserve(kBufferKeys);
+}
+
+template <typename Key>
+s21::SortedFileWriter<Key>::SortedFileWriter(int fd, bool multi) : fd_(fd) {
+  start_ = ::lseek(fd, 0, SEEK_CUR);
+  if (start_ < 0) {
+    throw std::runtime_error("sorted file: descriptor is not seekable");
+  }
+  header_.key_size_ = sizeof(Key);
+  header_.flags_ = multi ? kSortedFileMulti : 0;
+  std::vector<char> page(kSortedFilePage);
+  Write(page.data(), page.size());
+  buffer_.reserve(kBufferKeys);
+}
+
+template <typename Key>
+void s21::SortedFileWriter<Key>::Add(const Key &key) {
+  buffer_.push_back(key);
+  ++header_.count_;
+  if (buffer_.size() == kBufferKeys) {
+    Flush();
+  }
+}
+
+template <typename Key>
+void s21::SortedFileWriter<Key>::Finish() {
+  Flush();
+  header_.checksum_ = checksum_.Value();
+  WriteAt(start_, &header_, sizeof(header_));
+}
+
+template <typename Key>
+void s21::SortedFileWriter<Key>::Flush() {
+  if (!buffer_.empty()) {
+    size_t len = buffer_.size() * sizeof(Key);
+    checksum_.Update(buffer_.data(), len);
+    Write(buffer_.data(), len);
+    buffer_.clear();
+  }
+}
+
+template <typename Key>
+void s21::SortedFileWriter<Key>::Write(const void *data, size_t len) {
+  if (os_) {
+    os_->write(static_cast<const char *>(data), len);
+    if (!*os_) {
+      throw std::runtime_error("sorted file: write failed");
+    }
+  } else {
+    const char *p = static_cast<const char *>(data);
+    while (len) {
+      ssize_t done = ::write(fd_, p, len);
+      if (done < 0 && errno != EINTR) {
+        throw std::runtime_error("sorted file: write failed");
+      }
+      if (done > 0) {
+        p += done;
+        len -= done;
+      }
+    }
+  }
+}
+
+template <typename Key>
+void s21::SortedFileWriter<Key>::WriteAt(int64_t pos, const void *data,
+                                         size_t len) {
+  if (os_) {
+    std::streampos end = os_->tellp();
+    os_->seekp(pos);
+    Write(data, len);
+    os_->seekp(end);
+  } else {
+    const char *p = static_cast<const char *>(data);
+    while (len) {
+      ssize_t done = ::pwrite(fd_, p, len, pos);
+      if (done < 0 && errno != EINTR) {
+        throw std::runtime_error("sorted file: write failed");
+      }
+      if (done > 0) {
+        p += done;
+        pos += done;
+        len -= done;
+      }
+    }
+  }
+}
+
+template <typename Key>
+s21::SortedFileReader<Key>::SortedFileReader(std::istream &is) : is_(&is) {
+  ReadExact(&header_, sizeof(header_));
+  header_.Check(sizeof(Key), alignof(Key));
+  std::vector<char> skip(header_.data_offset_ - sizeof(header_));
+  ReadExact(skip.data(), skip.size());
+}
+
+template <typename Key>
+s21::SortedFileReader<Key>::SortedFileReader(int fd) : fd_(fd) {
+  ReadExact(&header_, sizeof(header_));
+  header_.Check(sizeof(Key), alignof(Key));
+  std::vector<char> skip(header_.data_offset_ - sizeof(header_));
+  ReadExact(skip.data(), skip.size());
+}
+
+template <typename Key>
+size_t s21::SortedFileReader<Key>::Read(Key *out, size_t n) {
+  if (n > header_.count_ - read_) {
+    n = header_.count_ - read_;
+  }
+  ReadExact(out, n * sizeof(Key));
+  checksum_.Update(out, n * sizeof(Key));
+  read_ += n;
+  return n;
+}
+
+template <typename Key>
+void s21::SortedFileReader<Key>::Verify() const {
+  if (read_ != header_.count_ || checksum_.Value() != header_.checksum_) {
+    throw std::runtime_error("sorted file: checksum mismatch");
+  }
+}
+
+template <typename Key>
+void s21::SortedFileReader<Key>::ReadExact(void *data, size_t len) {
+  if (is_) {
+    is_->read(static_cast<char *>(data), len);
+    if (static_cast<size_t>(is_->gcount()) != len) {
+      throw std::runtime_error("sorted file: unexpected end of data");
+    }
+  } else {
+    char *p = static_cast<char *>(data);
+    while (len) {
+      ssize_t done = ::read(fd_, p, len);
+      if (done == 0 || (done < 0 && errno != EINTR)) {
+        throw std::runtime_error("sorted file: unexpected end of data");
+      }
+      if (done > 0) {
+        p += done;
+        len -= done;
+      }
+    }
+  }
+}
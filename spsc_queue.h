@@ -0,0 +1,64 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace s21 {
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. The capacity is rounded up to a power of two and allocated once.
+//
+// head_ is written only by the consumer and tail_ only by the producer, each
+// on its own cache line next to that thread's cached copy of the other
+// index, so the threads touch each other's line only when the cached value
+// says the queue looks full or empty.
+template <typename T>
+class spsc_queue {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+  explicit spsc_queue(size_type capacity);
+  spsc_queue(const spsc_queue &) = delete;
+  spsc_queue &operator=(const spsc_queue &) = delete;
+  ~spsc_queue();
+
+  // producer side, false when the queue is full
+  bool try_push(const T &value) { return try_emplace(value); }
+  bool try_push(T &&value) { return try_emplace(std::move(value)); }
+  template <typename... Args>
+  bool try_emplace(Args &&...args);
+
+  // consumer side, false when the queue is empty
+  bool try_pop(T &out);
+
+  size_type capacity() const { return mask_ + 1; }
+  // exact only when neither side is running; head_ is read first, so the
+  // tail read after it is never behind it and the difference cannot wrap
+  size_type size_approx() const {
+    size_type head = head_.load(std::memory_order_acquire);
+    size_type tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+  }
+  bool empty_approx() const { return size_approx() == 0; }
+
+ private:
+  static constexpr size_t kCacheLine = 64;
+
+  // read-only after construction, shared by both sides
+  alignas(kCacheLine) T *slots_;
+  size_type mask_;
+
+  alignas(kCacheLine) std::atomic<size_type> head_{0};
+  size_type cached_tail_ = 0;
+
+  alignas(kCacheLine) std::atomic<size_type> tail_{0};
+  // the class alignment pads this line up to the next object
+  size_type cached_head_ = 0;
+};
+}  // namespace s21
+
+#include "spsc_queue.tpp"
+
+#endif
@@ -0,0 +1,57 @@
+#include <memory>
+#include <new>
+
+#include "spsc_queue.h"
+
+template <typename T>
+s21::spsc_queue<T>::spsc_queue(size_type capacity) {
+  size_type n = 2;
+  while (n < capacity) {
+    n *= 2;
+  }
+  slots_ = std::allocator<T>().allocate(n);
+  mask_ = n - 1;
+}
+
+template <typename T>
+s21::spsc_queue<T>::~spsc_queue() {
+  size_type tail = tail_.load(std::memory_order_relaxed);
+  for (size_type i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+    std::destroy_at(slots_ + (i & mask_));
+  }
+  std::allocator<T>().deallocate(slots_, mask_ + 1);
+}
+
+// the slot is filled before the release store of tail_ publishes it
+template <typename T>
+template <typename... Args>
+bool s21::spsc_queue<T>::try_emplace(Args &&...args) {
+  size_type tail = tail_.load(std::memory_order_relaxed);
+  if (tail - cached_head_ > mask_) {
+    cached_head_ = head_.load(std::memory_order_acquire);
+    if (tail - cached_head_ > mask_) {
+      return false;
+    }
+  }
+  ::new (static_cast<void *>(slots_ + (tail & mask_)))
+      T(std::forward<Args>(args)...);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+// the slot is emptied before the release store of head_ hands it back
+template <typename T>
+bool s21::spsc_queue<T>::try_pop(T &out) {
+  size_type head = head_.load(std::memory_order_relaxed);
+  if (head == cached_tail_) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    if (head == cached_tail_) {
+      return false;
+    }
+  }
+  T *slot = slots_ + (head & mask_);
+  out = std::move(*slot);
+  std::destroy_at(slot);
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
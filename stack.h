@@ -0,0 +1,57 @@
+#ifndef STACK_H
+#define STACK_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+#include "ring_buffer.h"
+
+namespace s21 {
+// LIFO stack over the same ring buffer as queue, pushing and popping at
+// the back.
+template <typename T>
+class stack {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  stack() = default;
+  stack(std::initializer_list<value_type> const &items);
+  stack(const stack &s) = default;
+  stack(stack &&s) noexcept = default;
+  ~stack() = default;
+  stack &operator=(const stack &s) = default;
+  stack &operator=(stack &&s) noexcept = default;
+
+  const_reference top() const { return ring_.Back(); }
+  reference top() { return ring_.Back(); }
+
+  bool empty() const { return ring_.Size() == 0; }
+  size_type size() const { return ring_.Size(); }
+  size_type capacity() const { return ring_.Capacity(); }
+  void reserve(size_type n) { ring_.Reserve(n); }
+
+  void push(const_reference value) { ring_.EmplaceBack(value); }
+  void push(T &&value) { ring_.EmplaceBack(std::move(value)); }
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return ring_.EmplaceBack(std::forward<Args>(args)...);
+  }
+  void pop() { ring_.PopBack(); }
+  void swap(stack &other) noexcept { ring_.Swap(other.ring_); }
+
+  // pushes the values in order, the last one ends on top
+  template <typename... Args>
+  void insert_many_back(Args &&...args);
+
+ private:
+  RingBuffer<T> ring_;
+};
+}  // namespace s21
+
+#include "stack.tpp"
+
+#endif
@@ -0,0 +1,16 @@
+#include "stack.h"
+
+template <typename T>
+s21::stack<T>::stack(std::initializer_list<value_type> const &items) {
+  ring_.Reserve(items.size());
+  for (const auto &item : items) {
+    push(item);
+  }
+}
+
+template <typename T>
+template <typename... Args>
+void s21::stack<T>::insert_many_back(Args &&...args) {
+  ring_.Reserve(size() + sizeof...(Args));
+  (ring_.EmplaceBack(std::forward<Args>(args)), ...);
+}
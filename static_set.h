@@ -0,0 +1,129 @@
+#ifndef STATIC_SET_H
+#define STATIC_SET_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <functional>
+
+namespace s21 {
+// Set of at most N keys fixed at compile time, for tables like reserved
+// names or opcodes: declared constexpr it is sorted and laid out by the
+// compiler, so nothing runs at startup, and every member can be used in
+// constant expressions. Duplicates are dropped, size() counts the rest.
+//
+// Lookups search a copy of the keys in Eytzinger order, the breadth-first
+// order of a complete binary search tree: the children of slot k are 2k
+// and 2k + 1, so the descent is a loop over one comparison with no
+// branch on its result, and the top levels of every search share cache
+// lines. Iteration goes over the keys in sorted order.
+template <typename Key, size_t N, typename Compare = std::less<Key>>
+class static_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using const_reference = const Key &;
+  using const_iterator = const Key *;
+  using iterator = const_iterator;
+  using size_type = size_t;
+
+  constexpr static_set() = default;
+  // the keys given, M of them; the slots past them stay unused
+  template <size_t M>
+    requires(M <= N)
+  constexpr explicit static_set(const std::array<Key, M> &keys,
+                                Compare comp = Compare())
+      : comp_(comp) {
+    Build(keys.data(), M);
+  }
+  template <size_t M>
+    requires(M <= N)
+  constexpr explicit static_set(const Key (&keys)[M], Compare comp = Compare())
+      : comp_(comp) {
+    Build(keys, M);
+  }
+  template <typename... Keys>
+    requires(sizeof...(Keys) < N)
+  constexpr static_set(const Key &first, const Keys &...rest)
+      : static_set(std::array<Key, 1 + sizeof...(Keys)>{first, rest...}) {}
+
+  constexpr const_iterator begin() const { return sorted_.data(); }
+  constexpr const_iterator end() const { return sorted_.data() + size_; }
+
+  constexpr bool empty() const { return size_ == 0; }
+  constexpr size_type size() const { return size_; }
+  static constexpr size_type max_size() { return N; }
+
+  constexpr const_iterator lower_bound(const Key &key) const {
+    return At(Descend(key, [this](const Key &a, const Key &b) {
+      return comp_(a, b);
+    }));
+  }
+  constexpr const_iterator upper_bound(const Key &key) const {
+    return At(Descend(key, [this](const Key &a, const Key &b) {
+      return !comp_(b, a);
+    }));
+  }
+  constexpr const_iterator find(const Key &key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp_(key, *it) ? it : end();
+  }
+  constexpr bool contains(const Key &key) const { return find(key) != end(); }
+  constexpr size_type count(const Key &key) const { return contains(key); }
+  constexpr key_compare key_comp() const { return comp_; }
+
+ private:
+  constexpr void Build(const Key *keys, size_t count) {
+    std::copy(keys, keys + count, sorted_.begin());
+    auto first = sorted_.begin(), last = first + count;
+    std::sort(first, last, comp_);
+    last = std::unique(first, last, [this](const Key &a, const Key &b) {
+      return !comp_(a, b) && !comp_(b, a);
+    });
+    size_ = last - first;
+    size_t next = 0;
+    Layout(1, next);
+  }
+
+  // fills the subtree of slot k with the keys from next on, in order
+  constexpr void Layout(size_t k, size_t &next) {
+    if (k <= size_) {
+      Layout(2 * k, next);
+      eytzinger_[k] = sorted_[next];
+      rank_[k] = next++;
+      Layout(2 * k + 1, next);
+    }
+  }
+
+  // The descent goes right past every slot that goes_right holds for and
+  // left otherwise, down to a leaf. The answer is the last slot where it
+  // went left: the trailing ones of k are the right turns since then, so
+  // dropping them and one more bit climbs back to it. 0 means no answer.
+  template <typename GoesRight>
+  constexpr size_t Descend(const Key &key, GoesRight goes_right) const {
+    size_t k = 1;
+    while (k <= size_) {
+      k = 2 * k + goes_right(eytzinger_[k], key);
+    }
+    return k >> (std::countr_one(k) + 1);
+  }
+
+  constexpr const_iterator At(size_t k) const {
+    return k ? sorted_.data() + rank_[k] : end();
+  }
+
+  std::array<Key, N> sorted_{};
+  // slot 0 is unused, rank_ maps a slot to the key's place in sorted_
+  std::array<Key, N + 1> eytzinger_{};
+  std::array<size_t, N + 1> rank_{};
+  size_t size_ = 0;
+  [[no_unique_address]] Compare comp_;
+};
+
+template <typename Key, typename... Keys>
+static_set(Key, Keys...) -> static_set<Key, 1 + sizeof...(Keys)>;
+}  // namespace s21
+
+#endif
@@ -1,6 +1,43 @@
 #include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <ranges>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+
+#include "bitmap_set.h"
+#include "cached_set.h"
+#include "external_sort.h"
+#include "filtered_set.h"
+#include "int_set.h"
+#include "interval_set.h"
+#include "list.h"
+#include "map.h"
+#include "mapped_set.h"
+#include "multimap.h"
 #include "multiset.h"
+#include "queue.h"
+#include "reclaimer.h"
 #include "set.h"
+#include "set_views.h"
+#include "sharded_set.h"
+#include "spsc_queue.h"
+#include "static_set.h"
+#include "stack.h"
+#include "unordered_multiset.h"
+#include "unordered_set.h"
+#include "vector.h"
 
 TEST(Multiset, Member_functions) {
   using s21::multiset;
@@ -346,6 +383,37 @@ TEST(Multiset, Lookup) {
   }
 }
 
+TEST(Multiset, NodeHandles) {
+  using s21::multiset;
+
+  multiset<int> a{1, 2, 2, 3};
+  multiset<int> b{2};
+
+  auto nh = a.extract(2);
+  ASSERT_FALSE(nh.empty());
+  EXPECT_EQ(nh.value(), 2);
+  EXPECT_EQ(a.count(2), 1u);
+  EXPECT_EQ(a.size(), 3u);
+
+  auto it = b.insert(std::move(nh));
+  EXPECT_TRUE(nh.empty());
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(b.count(2), 2u);
+
+  auto missing = a.extract(10);
+  EXPECT_TRUE(missing.empty());
+  EXPECT_EQ(b.insert(std::move(missing)), b.end());
+
+  auto first = a.extract(a.begin());
+  EXPECT_EQ(first.value(), 1);
+  first.value() = 7;
+  a.insert(std::move(first));
+  auto last = a.end();
+  --last;
+  EXPECT_EQ(*last, 7);
+  EXPECT_EQ(a.size(), 3u);
+}
+
 TEST(SetTest, DelNesk) {
   s21::set<int> s{26, 17, 41, 14, 21, 30, 47, 10, 19, 23, 38, 7, 12, 35, 39};
   auto it = s.find(41);
@@ -513,6 +581,57 @@ TEST(SetTest, Merge) {
   EXPECT_TRUE(s2.contains(3));
 }
 
+TEST(SetTest, MergeRelinksNodes) {
+  s21::set<int> s1{1, 2, 3};
+  s21::set<int> s2{3, 4, 5};
+  const int *four = &*s2.find(4);
+
+  s1.merge(s2);
+
+  EXPECT_EQ(&*s1.find(4), four);
+  EXPECT_EQ(s1.size(), 5u);
+  EXPECT_EQ(s2.size(), 1u);
+
+  s1.merge(s1);
+  EXPECT_EQ(s1.size(), 5u);
+}
+
+TEST(SetTest, NodeHandles) {
+  s21::set<int> a{1, 2, 3};
+  s21::set<int> b{3};
+
+  auto nh = a.extract(2);
+  ASSERT_FALSE(nh.empty());
+  EXPECT_EQ(nh.value(), 2);
+  EXPECT_FALSE(a.contains(2));
+  EXPECT_EQ(a.size(), 2u);
+
+  auto res = b.insert(std::move(nh));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_TRUE(res.node.empty());
+  EXPECT_EQ(*res.position, 2);
+  EXPECT_TRUE(b.contains(2));
+
+  auto dup = a.extract(a.find(3));
+  res = b.insert(std::move(dup));
+  EXPECT_FALSE(res.inserted);
+  EXPECT_EQ(*res.position, 3);
+  ASSERT_FALSE(res.node.empty());
+  EXPECT_EQ(res.node.value(), 3);
+
+  res.node.value() = 10;
+  res = b.insert(std::move(res.node));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_TRUE(b.contains(10));
+
+  auto missing = a.extract(42);
+  EXPECT_TRUE(missing.empty());
+  res = b.insert(std::move(missing));
+  EXPECT_FALSE(res.inserted);
+  EXPECT_EQ(res.position, b.end());
+  EXPECT_EQ(b.size(), 3u);
+}
+
 TEST(SetTest, Find) {
   s21::set<int> s{1, 2, 3, 4, 5};
 
@@ -609,6 +728,1861 @@ TEST(SetTest, StringSet) {
   EXPECT_EQ(*it, "banana");
 }
 
+TEST(TreeStats, CountsTreeWork) {
+  using Tree = s21::RBTree<int, int, s21::SetKeyOfValue<int>, std::less<int>,
+                           s21::NoAugment, s21::CountingTreeStats>;
+  Tree tree;
+  for (int i = 0; i < 1000; ++i) {
+    tree.Insert(i);
+  }
+
+  s21::TreeStats st = tree.GetStats();
+  EXPECT_EQ(st.allocations, 1000u);
+  EXPECT_EQ(st.frees, 0u);
+  EXPECT_GT(st.rotations, 0u);
+  EXPECT_GT(st.recolorings, 0u);
+  EXPECT_GT(st.comparisons, 0u);
+  EXPECT_EQ(st.lookups, 1000u);
+  EXPECT_LE(st.max_depth, 20u);
+
+  tree.ResetStats();
+  EXPECT_NE(tree.Search(500), nullptr);
+  EXPECT_EQ(tree.Search(5000), nullptr);
+  st = tree.GetStats();
+  EXPECT_EQ(st.lookups, 2u);
+  EXPECT_EQ(st.rotations, 0u);
+  EXPECT_GE(st.average_depth(), 1.0);
+  EXPECT_LE(st.average_depth(), static_cast<double>(st.max_depth));
+
+  for (int i = 0; i < 1000; ++i) {
+    tree.DelNode(tree.Search(i));
+  }
+  EXPECT_EQ(tree.GetRoot(), nullptr);
+  EXPECT_EQ(tree.GetStats().frees, 1000u);
+}
+
+TEST(TreeStats, DefaultPolicy) {
+  s21::set<int> s{1, 2, 3};
+  s.find(2);
+  s21::TreeStats st = s.stats();
+  if (s21::DefaultTreeStats::kEnabled) {
+    EXPECT_EQ(st.allocations, 3u);
+    EXPECT_GT(st.comparisons, 0u);
+    s.reset_stats();
+    EXPECT_EQ(s.stats().comparisons, 0u);
+  } else {
+    EXPECT_EQ(st.comparisons, 0u);
+    EXPECT_EQ(st.allocations, 0u);
+  }
+  EXPECT_TRUE(std::is_empty_v<s21::NoTreeStats>);
+}
+
+TEST(TreeShape, InspectAndValidate) {
+  s21::set<int> empty;
+  EXPECT_TRUE(empty.validate());
+  EXPECT_EQ(empty.inspect().height, 0u);
+
+  s21::set<int> s;
+  for (int i = 0; i < 1023; ++i) {
+    s.insert(i);
+  }
+  s21::TreeShape shape = s.inspect();
+  EXPECT_EQ(shape.size, 1023u);
+  EXPECT_GE(shape.height, 10u);
+  EXPECT_LE(shape.height, 2 * shape.black_height);
+  EXPECT_EQ(shape.depth_histogram.size(), shape.height);
+  EXPECT_EQ(shape.depth_histogram[0], 1u);
+  size_t total = 0;
+  for (size_t cnt : shape.depth_histogram) total += cnt;
+  EXPECT_EQ(total, shape.size);
+  EXPECT_EQ(shape.payload_bytes, 1023 * sizeof(int));
+  EXPECT_GE(shape.allocated_bytes, shape.node_bytes);
+  EXPECT_GT(shape.overhead_bytes(), 0u);
+  EXPECT_GE(shape.fragmentation(), 0.0);
+  EXPECT_TRUE(s.validate());
+
+  using Tree = s21::RBTree<int, int, s21::SetKeyOfValue<int>>;
+  Tree tree;
+  for (int i = 0; i < 10; ++i) {
+    tree.Insert(i);
+  }
+  EXPECT_TRUE(tree.Validate(true));
+  tree.GetRoot()->color_ = s21::RED;
+  EXPECT_FALSE(tree.Validate(true));
+  tree.GetRoot()->color_ = s21::BLACK;
+  std::swap(tree.GetRoot()->data_, tree.GetRoot()->left_->data_);
+  EXPECT_FALSE(tree.Validate(true));
+}
+
+TEST(TreeShape, RandomOperationsKeepInvariants) {
+  std::mt19937 gen(3);
+  s21::set<int> s;
+  s21::multiset<int> ms;
+  s21::interval_set<int> iv;
+
+  for (int i = 0; i < 3000; ++i) {
+    int key = gen() % 500;
+    if (gen() % 3 == 0) {
+      auto it = s.find(key);
+      if (it != s.end()) s.erase(it);
+      auto mit = ms.find(key);
+      if (mit != ms.end()) ms.erase(mit);
+      iv.erase({key, key + 10});
+    } else {
+      s.insert(key);
+      ms.insert(key);
+      iv.insert(key, key + 10);
+    }
+    ASSERT_TRUE(s.validate());
+    ASSERT_TRUE(ms.validate());
+    ASSERT_TRUE(iv.validate());
+  }
+  EXPECT_FALSE(ms.empty());
+}
+
+TEST(IntervalSet, Basics) {
+  s21::interval_set<int> s{{1, 5}, {3, 4}, {10, 20}};
+  EXPECT_EQ(s.size(), 3u);
+  EXPECT_FALSE(s.insert(3, 4).second);
+  EXPECT_FALSE(s.insert(7, 7).second);
+  EXPECT_TRUE(s.insert(3, 8).second);
+  EXPECT_TRUE(s.contains({3, 8}));
+
+  std::vector<std::pair<int, int>> at3 = s.overlaps(3);
+  std::vector<std::pair<int, int>> expected{{1, 5}, {3, 4}, {3, 8}};
+  EXPECT_EQ(at3, expected);
+
+  EXPECT_TRUE(s.overlaps(5).size() == 1u);
+  EXPECT_TRUE(s.overlaps(8).empty());
+  EXPECT_TRUE(s.overlaps(20).empty());
+
+  std::vector<std::pair<int, int>> out;
+  s.overlaps(std::make_pair(4, 11), std::back_inserter(out));
+  expected = {{1, 5}, {3, 8}, {10, 20}};
+  EXPECT_EQ(out, expected);
+  EXPECT_TRUE(s.overlaps_any({19, 30}));
+  EXPECT_FALSE(s.overlaps_any({8, 10}));
+
+  EXPECT_EQ(s.erase({1, 5}), 1u);
+  EXPECT_EQ(s.erase({1, 5}), 0u);
+  EXPECT_EQ(s.overlaps(2).size(), 0u);
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.overlaps(3).empty());
+}
+
+TEST(IntervalSet, MatchesBruteForce) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> start(0, 1000);
+  std::uniform_int_distribution<int> len(1, 60);
+  s21::interval_set<int> s;
+  std::vector<std::pair<int, int>> all;
+
+  for (int i = 0; i < 2000; ++i) {
+    int a = start(gen);
+    std::pair<int, int> iv(a, a + len(gen));
+    if (i % 3 == 2 && !all.empty()) {
+      std::pair<int, int> victim = all[gen() % all.size()];
+      s.erase(s.find(victim));
+      all.erase(std::find(all.begin(), all.end(), victim));
+    } else if (s.insert(iv).second) {
+      all.push_back(iv);
+    }
+  }
+  std::sort(all.begin(), all.end());
+
+  for (int q = 0; q < 300; ++q) {
+    int lo = start(gen);
+    int hi = lo + len(gen);
+    std::vector<std::pair<int, int>> by_point, by_range;
+    for (const auto &iv : all) {
+      if (iv.first <= lo && lo < iv.second) by_point.push_back(iv);
+      if (iv.first < hi && lo < iv.second) by_range.push_back(iv);
+    }
+    EXPECT_EQ(s.overlaps(lo), by_point);
+    EXPECT_EQ(s.overlaps(std::make_pair(lo, hi)), by_range);
+    EXPECT_EQ(s.overlaps_any({lo, hi}), !by_range.empty());
+  }
+}
+
+namespace {
+// a value whose move may throw, so containers copy it when they grow, and
+// whose copies throw once copies_left copies have been made, none when it
+// is negative
+struct FragileKey {
+  static inline int copies_left = -1;
+  int value;
+  FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (copies_left == 0) {
+      throw std::runtime_error("copy");
+    }
+    copies_left -= copies_left > 0;
+  }
+  FragileKey(FragileKey &&other) : value(other.value) {}
+  FragileKey &operator=(const FragileKey &) = default;
+  bool operator==(const FragileKey &other) const {
+    return value == other.value;
+  }
+};
+
+struct SubtreeSum {
+  using value_type = long;
+  static constexpr bool kEnabled = true;
+
+  template <typename Node>
+  static void Update(Node *node) {
+    node->aug_ = node->data_ + (node->left_ ? node->left_->aug_ : 0) +
+                 (node->right_ ? node->right_->aug_ : 0);
+  }
+};
+}  // namespace
+
+TEST(RBTreeAugment, SubtreeSum) {
+  using Tree = s21::RBTree<int, int, s21::SetKeyOfValue<int>, std::less<int>,
+                           SubtreeSum>;
+  Tree tree;
+  long expected = 0;
+  for (int i = 1; i <= 500; ++i) {
+    tree.Insert((i * 37) % 1000);
+    expected += (i * 37) % 1000;
+  }
+  EXPECT_EQ(tree.GetRoot()->aug_, expected);
+
+  for (int i = 1; i <= 500; i += 2) {
+    tree.DelNode(tree.Search((i * 37) % 1000));
+    expected -= (i * 37) % 1000;
+  }
+  EXPECT_EQ(tree.GetRoot()->aug_, expected);
+
+  Tree copy(tree);
+  EXPECT_EQ(copy.GetRoot()->aug_, expected);
+}
+
+TEST(IntSet, Basics) {
+  s21::int_set<uint32_t> s{5, 1, 4000000000u, 64, 63};
+  EXPECT_EQ(s.size(), 5u);
+  EXPECT_FALSE(s.insert(64).second);
+  EXPECT_TRUE(s.insert(0).second);
+  EXPECT_TRUE(s.contains(4000000000u));
+  EXPECT_FALSE(s.contains(65));
+  EXPECT_EQ(s.find(65), s.end());
+
+  std::vector<uint32_t> keys(s.begin(), s.end());
+  std::vector<uint32_t> expected{0, 1, 5, 63, 64, 4000000000u};
+  EXPECT_EQ(keys, expected);
+
+  EXPECT_EQ(*s.lower_bound(6), 63u);
+  EXPECT_EQ(*s.lower_bound(63), 63u);
+  EXPECT_EQ(*s.upper_bound(63), 64u);
+  EXPECT_EQ(*s.upper_bound(65), 4000000000u);
+  EXPECT_EQ(s.upper_bound(4000000000u), s.end());
+
+  auto it = s.end();
+  --it;
+  EXPECT_EQ(*it, 4000000000u);
+  --it;
+  EXPECT_EQ(*it, 64u);
+
+  EXPECT_EQ(s.erase(64), 1u);
+  EXPECT_EQ(s.erase(64), 0u);
+  s.erase(s.find(4000000000u));
+  EXPECT_EQ(s.size(), 4u);
+  EXPECT_EQ(s.upper_bound(63), s.end());
+
+  s21::int_set<uint32_t> other{1, 2, 3};
+  s.merge(other);
+  EXPECT_EQ(s.size(), 6u);
+  EXPECT_EQ(other.size(), 1u);
+  EXPECT_TRUE(other.contains(1));
+
+  s21::int_set<uint32_t> copy(s);
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.begin(), s.end());
+  EXPECT_EQ(copy.size(), 6u);
+}
+
+TEST(IntSet, MatchesStdSet) {
+  std::mt19937_64 gen(11);
+  s21::int_set<uint64_t> s;
+  std::set<uint64_t> ref;
+
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t key = i % 2 ? gen() : gen() % 5000;
+    if (i % 4 == 3) {
+      EXPECT_EQ(s.erase(key % 5000), ref.erase(key % 5000));
+    } else {
+      EXPECT_EQ(s.insert(key).second, ref.insert(key).second);
+    }
+  }
+  EXPECT_EQ(s.size(), ref.size());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), ref.begin(), ref.end()));
+
+  for (int i = 0; i < 2000; ++i) {
+    uint64_t key = i % 2 ? gen() : gen() % 6000;
+    auto lb = s.lower_bound(key);
+    auto ref_lb = ref.lower_bound(key);
+    ASSERT_EQ(lb == s.end(), ref_lb == ref.end());
+    if (ref_lb != ref.end()) {
+      EXPECT_EQ(*lb, *ref_lb);
+    }
+    EXPECT_EQ(s.contains(key), ref.count(key) == 1);
+  }
+
+  std::vector<uint64_t> backwards;
+  for (auto it = s.end(); it != s.begin();) {
+    --it;
+    backwards.push_back(*it);
+  }
+  EXPECT_TRUE(std::equal(backwards.begin(), backwards.end(), ref.rbegin()));
+}
+
+TEST(BitmapSet, Basics) {
+  s21::bitmap_set s{7, 70000, 3, 65535, 65536};
+  EXPECT_EQ(s.size(), 5u);
+  EXPECT_FALSE(s.insert(7).second);
+  EXPECT_TRUE(s.contains(65536));
+  EXPECT_FALSE(s.contains(8));
+
+  std::vector<uint32_t> keys(s.begin(), s.end());
+  std::vector<uint32_t> expected{3, 7, 65535, 65536, 70000};
+  EXPECT_EQ(keys, expected);
+
+  EXPECT_EQ(*s.lower_bound(8), 65535u);
+  EXPECT_EQ(*s.upper_bound(65535), 65536u);
+  EXPECT_EQ(s.lower_bound(70001), s.end());
+  auto last = s.end();
+  --last;
+  EXPECT_EQ(*last, 70000u);
+
+  EXPECT_EQ(s.erase(65535), 1u);
+  EXPECT_EQ(s.erase(65535), 0u);
+  s.erase(s.find(3));
+  EXPECT_EQ(*s.begin(), 7u);
+  EXPECT_EQ(s.size(), 3u);
+
+  s21::bitmap_set other{7, 8};
+  s.merge(other);
+  EXPECT_EQ(s.size(), 4u);
+  EXPECT_EQ(other.size(), 1u);
+  EXPECT_TRUE(other.contains(7));
+}
+
+TEST(BitmapSet, DenseChunksAndAlgebra) {
+  s21::bitmap_set evens, threes;
+  std::set<uint32_t> ref_evens, ref_threes;
+  for (uint32_t i = 0; i < 300000; i += 2) {
+    evens.insert(i);
+    ref_evens.insert(i);
+  }
+  for (uint32_t i = 100000; i < 400000; i += 3) {
+    threes.insert(i);
+    ref_threes.insert(i);
+  }
+  EXPECT_EQ(evens.size(), ref_evens.size());
+  EXPECT_LT(evens.memory_usage(), ref_evens.size());
+
+  auto check = [](const s21::bitmap_set &got, const std::set<uint32_t> &ref) {
+    EXPECT_EQ(got.size(), ref.size());
+    EXPECT_TRUE(std::equal(got.begin(), got.end(), ref.begin(), ref.end()));
+  };
+
+  std::set<uint32_t> ref;
+  std::set_union(ref_evens.begin(), ref_evens.end(), ref_threes.begin(),
+                 ref_threes.end(), std::inserter(ref, ref.end()));
+  check(evens | threes, ref);
+
+  ref.clear();
+  std::set_intersection(ref_evens.begin(), ref_evens.end(),
+                        ref_threes.begin(), ref_threes.end(),
+                        std::inserter(ref, ref.end()));
+  check(evens & threes, ref);
+
+  ref.clear();
+  std::set_difference(ref_evens.begin(), ref_evens.end(), ref_threes.begin(),
+                      ref_threes.end(), std::inserter(ref, ref.end()));
+  s21::bitmap_set diff = evens - threes;
+  check(diff, ref);
+
+  std::vector<uint32_t> backwards;
+  for (auto it = diff.end(); it != diff.begin();) {
+    --it;
+    backwards.push_back(*it);
+  }
+  EXPECT_TRUE(std::equal(backwards.begin(), backwards.end(), ref.rbegin()));
+
+  for (uint32_t i = 0; i < 300000; i += 4) {
+    evens.erase(i);
+    ref_evens.erase(i);
+  }
+  check(evens, ref_evens);
+  EXPECT_EQ(*evens.lower_bound(4), 6u);
+}
+
+TEST(SortedFile, SetRoundTrip) {
+  s21::set<int> a;
+  for (int i = 0; i < 100000; ++i) a.insert((i * 7919) % 100003);
+
+  std::stringstream ss;
+  a.serialize(ss);
+  s21::set<int> b = s21::set<int>::deserialize(ss);
+  EXPECT_EQ(b.size(), a.size());
+  for (auto i = a.begin(), j = b.begin(); i != a.end(); ++i, ++j) {
+    EXPECT_EQ(*i, *j);
+  }
+  EXPECT_TRUE(b.validate());
+  EXPECT_LE(b.inspect().height, a.inspect().height);
+
+  std::stringstream empty;
+  s21::set<int>().serialize(empty);
+  EXPECT_TRUE(s21::set<int>::deserialize(empty).empty());
+
+  std::string bytes = ss.str();
+  bytes[bytes.size() - 1] ^= 1;
+  std::stringstream damaged(bytes);
+  EXPECT_THROW(s21::set<int>::deserialize(damaged), std::runtime_error);
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 3));
+  EXPECT_THROW(s21::set<int>::deserialize(truncated), std::runtime_error);
+  std::stringstream foreign(ss.str());
+  EXPECT_THROW(s21::set<long long>::deserialize(foreign), std::runtime_error);
+}
+
+TEST(SortedFile, MultisetAndMappedView) {
+  s21::multiset<uint64_t> a;
+  for (uint64_t i = 0; i < 5000; ++i) a.insert(i / 3 * 2);
+
+  char path[] = "/tmp/s21_sorted_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  a.serialize(fd);
+  ASSERT_EQ(lseek(fd, 0, SEEK_SET), 0);
+  s21::multiset<uint64_t> b = s21::multiset<uint64_t>::deserialize(fd);
+  close(fd);
+  EXPECT_EQ(b.size(), a.size());
+  EXPECT_TRUE(b.validate());
+  std::istringstream garbage("S21SORT");
+  EXPECT_THROW(s21::set<uint64_t>::deserialize(garbage), std::runtime_error);
+
+  s21::mapped_set<uint64_t> view(path, true);
+  EXPECT_TRUE(view.multi());
+  ASSERT_EQ(view.size(), a.size());
+  const uint64_t *key = view.begin();
+  for (auto it = a.begin(); it != a.end(); ++it, ++key) {
+    EXPECT_EQ(*key, *it);
+  }
+  for (auto it = b.begin(), ref = a.begin(); it != b.end(); ++it, ++ref) {
+    EXPECT_EQ(*it, *ref);
+  }
+  EXPECT_TRUE(view.contains(10));
+  EXPECT_FALSE(view.contains(11));
+  EXPECT_EQ(view.count(10), 3u);
+  EXPECT_EQ(*view.lower_bound(11), 12u);
+  EXPECT_EQ(*view.upper_bound(12), 14u);
+  EXPECT_EQ(view.find(1 << 20), view.end());
+
+  s21::mapped_set<uint64_t> moved(std::move(view));
+  EXPECT_TRUE(view.empty());
+  EXPECT_TRUE(moved.verify());
+  EXPECT_THROW(s21::mapped_set<int>{path}, std::runtime_error);
+
+  // a data offset the keys can not be read at in place is rejected
+  s21::SortedFileHeader header;
+  fd = open(path, O_RDWR);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(pread(fd, &header, sizeof(header), 0),
+            static_cast<ssize_t>(sizeof(header)));
+  header.data_offset_ = s21::kSortedFilePage - 4;
+  ASSERT_EQ(pwrite(fd, &header, sizeof(header), 0),
+            static_cast<ssize_t>(sizeof(header)));
+  close(fd);
+  try {
+    s21::mapped_set<uint64_t> misaligned(path);
+    ADD_FAILURE() << "misaligned data offset accepted";
+  } catch (const std::runtime_error &e) {
+    EXPECT_STREQ(e.what(), "sorted file: misaligned data offset");
+  }
+  unlink(path);
+  EXPECT_THROW(s21::mapped_set<uint64_t>{path}, std::runtime_error);
+}
+
+TEST(ExternalSort, MergesRuns) {
+  std::mt19937 gen(34);
+  std::uniform_int_distribution<int> dist(0, 20000);
+  s21::external_sorter<int> unique(1000);
+  s21::external_sorter<int, std::less<int>, true> multi(1000);
+  std::set<int> ref;
+  std::multiset<int> ref_multi;
+  for (int i = 0; i < 30000; ++i) {
+    int key = dist(gen);
+    unique.push(key);
+    multi.push(key);
+    ref.insert(key);
+    ref_multi.insert(key);
+  }
+  EXPECT_EQ(unique.runs(), 30u);
+  EXPECT_EQ(multi.pushed(), 30000u);
+
+  char path[] = "/tmp/s21_merged_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  EXPECT_EQ(unique.write(path), ref.size());
+  EXPECT_EQ(unique.runs(), 0u);
+
+  s21::mapped_set<int> view(path, true);
+  EXPECT_FALSE(view.multi());
+  EXPECT_TRUE(std::equal(view.begin(), view.end(), ref.begin(), ref.end()));
+
+  s21::sorted_file_cursor<int> cursor(path, 64);
+  std::vector<int> scanned;
+  for (; cursor; ++cursor) scanned.push_back(*cursor);
+  EXPECT_TRUE(std::equal(scanned.begin(), scanned.end(), ref.begin(),
+                         ref.end()));
+  for (int i = 0; i < 1000; ++i) {
+    int key = dist(gen) + (i % 2 ? 0 : 1);
+    auto it = ref.lower_bound(key);
+    ASSERT_EQ(cursor.lower_bound(key), it != ref.end());
+    if (it != ref.end()) {
+      EXPECT_EQ(*cursor, *it);
+      ++cursor;
+      if (++it != ref.end()) {
+        EXPECT_EQ(*cursor, *it);
+      }
+    }
+  }
+  EXPECT_FALSE(cursor.lower_bound(20001));
+  cursor.rewind();
+  EXPECT_EQ(*cursor, *ref.begin());
+  unlink(path);
+
+  EXPECT_THROW(multi.build(ref_multi.size() - 1), std::length_error);
+  EXPECT_EQ(multi.pushed(), 0u);
+  for (int key : ref_multi) multi.push(key);
+  s21::multiset<int> built = multi.build(ref_multi.size());
+  EXPECT_EQ(built.size(), ref_multi.size());
+  EXPECT_TRUE(built.validate());
+  auto ref_it = ref_multi.begin();
+  for (auto it = built.begin(); it != built.end(); ++it, ++ref_it) {
+    EXPECT_EQ(*it, *ref_it);
+  }
+  int unordered[] = {2, 1};
+  EXPECT_THROW(s21::set<int>::from_sorted(unordered, 2), std::invalid_argument);
+
+  // a key that cannot be copied halfway through frees the nodes built
+  auto by_value = [](const FragileKey &a, const FragileKey &b) {
+    return a.value < b.value;
+  };
+  std::vector<FragileKey> fragile;
+  for (int i = 0; i < 100; ++i) fragile.push_back(i);
+  FragileKey::copies_left = 60;
+  EXPECT_THROW((s21::set<FragileKey, decltype(by_value)>::from_sorted(
+                   fragile.data(), fragile.size())),
+               std::runtime_error);
+  FragileKey::copies_left = -1;
+}
+
+TEST(Map, Basics) {
+  s21::map<int, std::string> m = {{3, "c"}, {1, "a"}, {2, "b"}};
+  EXPECT_EQ(m.size(), 3u);
+  EXPECT_EQ(m.at(2), "b");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+  EXPECT_EQ(m[4], "");
+  m[4] = "d";
+  EXPECT_EQ(m.at(4), "d");
+
+  auto res = m.insert(1, "x");
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(res.first->second, "a");
+  res = m.insert_or_assign(1, "x");
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(m[1], "x");
+  res = m.insert_or_assign(0, "z");
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(m.begin()->first, 0);
+
+  res = m.try_emplace(5, 3, 'e');
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ(res.first->second, "eee");
+  EXPECT_FALSE(m.try_emplace(5, "lost").second);
+  EXPECT_EQ(m[5], "eee");
+  EXPECT_FALSE(m.emplace(5, "lost").second);
+  EXPECT_TRUE(m.emplace(std::piecewise_construct, std::forward_as_tuple(6),
+                        std::forward_as_tuple(2, 'f'))
+                  .second);
+  EXPECT_EQ(m.at(6), "ff");
+
+  EXPECT_EQ(m.erase(0), 1u);
+  EXPECT_EQ(m.erase(0), 0u);
+  auto nh = m.extract(6);
+  ASSERT_FALSE(nh.empty());
+  EXPECT_EQ(nh.value().second, "ff");
+  EXPECT_TRUE(m.insert(std::move(nh)).inserted);
+  EXPECT_TRUE(m.contains(6));
+
+  s21::map<int, std::string> other = {{6, "dup"}, {7, "g"}};
+  m.merge(other);
+  EXPECT_EQ(m.at(7), "g");
+  EXPECT_EQ(other.size(), 1u);
+  EXPECT_EQ(other.at(6), "dup");
+
+  std::vector<int> keys;
+  for (auto it = m.begin(); it != m.end(); ++it) keys.push_back(it->first);
+  EXPECT_EQ(keys, std::vector<int>({1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(m.lower_bound(4)->second, "d");
+  EXPECT_EQ(m.upper_bound(7), m.end());
+  EXPECT_TRUE(m.validate());
+
+  s21::map<std::string, int, std::less<>> words;
+  words["beta"] = 2;
+  words["alpha"] = 1;
+  std::string_view key = "beta";
+  EXPECT_EQ(words.find(key)->second, 2);
+  EXPECT_TRUE(words.contains("alpha"));
+  EXPECT_FALSE(words.contains(std::string_view("gamma")));
+  EXPECT_EQ(words.lower_bound("b")->first, "beta");
+}
+
+TEST(Map, OneDescentAndHints) {
+  using Map = s21::map<int, int>;
+  Map m;
+  std::map<int, int> ref;
+  for (int i = 0; i < 2000; ++i) {
+    m.insert(m.end(), {i * 2, i});
+    ref[i * 2] = i;
+  }
+  auto it = m.find(1000);
+  for (int i = 999; i > 900; i -= 2) {
+    it = m.try_emplace(it, i, -i);
+    ref[i] = -i;
+  }
+  m.emplace_hint(m.begin(), 1, 1);
+  m.emplace_hint(m.end(), 1, 2);
+  ref.emplace(1, 1);
+  EXPECT_TRUE(m.validate());
+  ASSERT_EQ(m.size(), ref.size());
+  auto ref_it = ref.begin();
+  for (auto cur = m.begin(); cur != m.end(); ++cur, ++ref_it) {
+    EXPECT_EQ(cur->first, ref_it->first);
+    EXPECT_EQ(cur->second, ref_it->second);
+  }
+
+  if constexpr (s21::DefaultTreeStats::kEnabled) {
+    m.reset_stats();
+    m[4001] = 1;
+    m.insert_or_assign(4001, 2);
+    m.try_emplace(4001, 3);
+    EXPECT_EQ(m.stats().lookups, 3u);
+    EXPECT_EQ(m.stats().allocations, 1u);
+  }
+}
+
+TEST(Multimap, Basics) {
+  s21::multimap<int, std::string> m = {{2, "b1"}, {1, "a"}, {2, "b2"}};
+  m.insert({2, "b3"});
+  m.emplace(3, "c");
+  EXPECT_EQ(m.size(), 5u);
+  EXPECT_EQ(m.count(2), 3u);
+
+  std::vector<std::string> values;
+  auto range = m.equal_range(2);
+  for (auto it = range.first; it != range.second; ++it) {
+    values.push_back(it->second);
+  }
+  EXPECT_EQ(values, std::vector<std::string>({"b1", "b2", "b3"}));
+  EXPECT_EQ(m.find(2)->second, "b1");
+  EXPECT_EQ(m.find(4), m.end());
+
+  m.emplace_hint(m.end(), 4, "d");
+  m.insert(m.find(2), {2, "b0"});
+  EXPECT_EQ(m.find(2)->second, "b0");
+  EXPECT_TRUE(m.validate());
+
+  s21::multimap<int, std::string> other = {{2, "x"}};
+  m.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(m.erase(2), 5u);
+  EXPECT_FALSE(m.contains(2));
+  EXPECT_EQ(m.size(), 3u);
+  EXPECT_TRUE(m.validate());
+}
+
+TEST(Vector, Basics) {
+  s21::vector<int> v = {1, 2, 3};
+  EXPECT_EQ(v.size(), 3u);
+  EXPECT_EQ(v.front(), 1);
+  EXPECT_EQ(v.back(), 3);
+  EXPECT_THROW(v.at(3), std::out_of_range);
+  for (int i = 4; i <= 100; ++i) v.push_back(i);
+  EXPECT_EQ(v.size(), 100u);
+  EXPECT_GE(v.capacity(), 100u);
+  for (size_t i = 0; i < v.size(); ++i) EXPECT_EQ(v[i], int(i) + 1);
+
+  v.insert(v.begin(), 0);
+  v.insert(v.begin() + 50, v[0]);
+  EXPECT_EQ(v[0], 0);
+  EXPECT_EQ(v[50], 0);
+  EXPECT_EQ(v[51], 50);
+  v.erase(v.begin() + 50);
+  v.erase(v.begin());
+  EXPECT_EQ(v[49], 50);
+  v.pop_back();
+  EXPECT_EQ(v.back(), 99);
+
+  auto it = v.insert_many(v.begin() + 1, -1, -2, -3);
+  EXPECT_EQ(*it, -1);
+  EXPECT_EQ(v[3], -3);
+  EXPECT_EQ(v[4], 2);
+  v.insert_many_back(7, 8);
+  EXPECT_EQ(v.back(), 8);
+  EXPECT_EQ(v.size(), 104u);
+
+  v.clear();
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 0u);
+  EXPECT_TRUE(v.empty());
+  v.emplace_back(5);
+  v.push_back(v.back());
+  EXPECT_EQ(v, s21::vector<int>({5, 5}));
+}
+
+TEST(Vector, SmallBufferAndRelocation) {
+  s21::vector<std::string, 4> v;
+  EXPECT_TRUE(v.is_inline());
+  EXPECT_EQ(v.capacity(), 4u);
+  v.insert_many_back("a", "b", std::string(40, 'c'));
+  EXPECT_TRUE(v.is_inline());
+  v.emplace_back(3, 'd');
+  v.push_back(v[2]);
+  EXPECT_FALSE(v.is_inline());
+  EXPECT_EQ(v[2], v[4]);
+  EXPECT_EQ(v[3], "ddd");
+
+  s21::vector<std::string, 4> copy = v;
+  s21::vector<std::string, 4> small = {"x"};
+  small.swap(v);
+  EXPECT_EQ(v.size(), 1u);
+  EXPECT_EQ(small, copy);
+  small.erase(small.begin() + 1, small.end());
+  small.shrink_to_fit();
+  EXPECT_TRUE(small.is_inline());
+  EXPECT_EQ(small[0], "a");
+
+  s21::vector<std::string, 4> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 5u);
+  EXPECT_EQ(moved[2], std::string(40, 'c'));
+
+  s21::vector<std::pair<int, int>, 2> pairs;
+  pairs.emplace(pairs.end(), 1, 2);
+  pairs.emplace(pairs.begin(), 0, 1);
+  pairs.emplace(pairs.begin() + 1, 5, 5);
+  EXPECT_FALSE(pairs.is_inline());
+  EXPECT_EQ(pairs[1].first, 5);
+  EXPECT_EQ(pairs[2].second, 2);
+
+  // the arguments may refer into the vector even when it has to grow
+  s21::vector<std::string, 2> alias{std::string(40, 'a'),
+                                    std::string(40, 'b')};
+  alias.insert_many_back(alias[0], alias[1]);
+  EXPECT_EQ(alias.size(), 4u);
+  EXPECT_EQ(alias[2], std::string(40, 'a'));
+  EXPECT_EQ(alias[3], std::string(40, 'b'));
+  alias.insert_many(alias.begin(), alias[3], alias[2]);
+  EXPECT_EQ(alias[0], std::string(40, 'b'));
+  EXPECT_EQ(alias[1], std::string(40, 'a'));
+  EXPECT_EQ(alias[5], std::string(40, 'b'));
+
+  // a copy that throws while growing leaves the vector as it was
+  s21::vector<FragileKey, 2> fragile{1, 2};
+  for (int k = 0; k < 2; ++k) {
+    FragileKey::copies_left = k;
+    EXPECT_THROW(fragile.emplace_back(3), std::runtime_error);
+    EXPECT_THROW(fragile.insert_many_back(3, 4), std::runtime_error);
+    EXPECT_THROW(fragile.reserve(8), std::runtime_error);
+  }
+  FragileKey::copies_left = -1;
+  EXPECT_TRUE(fragile.is_inline());
+  EXPECT_EQ(fragile.size(), 2u);
+  EXPECT_EQ(fragile[1].value, 2);
+  fragile.emplace_back(3);
+  EXPECT_EQ(fragile[2].value, 3);
+
+  s21::set<int> s;
+  auto results = s.insert_many(3, 1, 3);
+  static_assert(decltype(results)::inline_capacity == 3);
+  EXPECT_TRUE(results.is_inline());
+  EXPECT_FALSE(results[2].second);
+}
+
+TEST(List, Basics) {
+  s21::list<int> l = {3, 1, 2};
+  l.push_front(0);
+  l.push_back(4);
+  EXPECT_EQ(l.size(), 5u);
+  EXPECT_EQ(l.front(), 0);
+  EXPECT_EQ(l.back(), 4);
+  auto it = l.insert_many(std::next(l.begin()), 7, 8);
+  EXPECT_EQ(*it, 7);
+  l.insert_many_front(-1);
+  l.insert_many_back(9);
+  EXPECT_EQ(std::vector<int>(l.begin(), l.end()),
+            std::vector<int>({-1, 0, 7, 8, 3, 1, 2, 4, 9}));
+  l.erase(l.begin());
+  l.pop_back();
+  l.pop_front();
+  l.reverse();
+  EXPECT_EQ(std::vector<int>(l.begin(), l.end()),
+            std::vector<int>({4, 2, 1, 3, 8, 7}));
+  l.sort();
+  EXPECT_EQ(std::vector<int>(l.begin(), l.end()),
+            std::vector<int>({1, 2, 3, 4, 7, 8}));
+
+  s21::list<int> other = {0, 2, 2, 9};
+  l.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(l.unique(), 2u);
+  EXPECT_EQ(std::vector<int>(l.begin(), l.end()),
+            std::vector<int>({0, 1, 2, 3, 4, 7, 8, 9}));
+
+  s21::list<std::pair<int, std::string>> pairs;
+  pairs.emplace_back(1, "a");
+  pairs.emplace(pairs.begin(), 0, "z");
+  EXPECT_EQ(pairs.front().second, "z");
+  s21::list<std::pair<int, std::string>> copy = pairs;
+  s21::list<std::pair<int, std::string>> moved(std::move(pairs));
+  EXPECT_TRUE(pairs.empty());
+  copy.swap(moved);
+  EXPECT_EQ(copy.back().second, "a");
+  s21::list<std::pair<int, std::string>>::const_iterator cit = copy.begin();
+  EXPECT_EQ(cit->first, 0);
+}
+
+TEST(List, PooledSpliceAndSort) {
+  auto pool = std::make_shared<s21::list<int>::pool_type>();
+  s21::list<int> lru(pool), spare(pool);
+  for (int i = 0; i < 100; ++i) lru.push_back(i);
+  size_t capacity = pool->capacity();
+  for (int i = 0; i < 1000; ++i) {
+    lru.erase(lru.begin());
+    lru.push_back(i);
+  }
+  EXPECT_EQ(pool->capacity(), capacity);
+  EXPECT_EQ(pool->in_use(), 100u);
+
+  // touching an entry moves its node to the front without reallocating it
+  auto hit = std::next(lru.begin(), 50);
+  int *address = &*hit;
+  lru.splice(lru.begin(), lru, hit);
+  EXPECT_EQ(&lru.front(), address);
+  spare.splice(spare.end(), lru, std::next(lru.begin()), lru.end());
+  EXPECT_EQ(lru.size(), 1u);
+  EXPECT_EQ(spare.size(), 99u);
+  EXPECT_EQ(pool->in_use(), 100u);
+
+  // nodes crossing to a list with another pool are relinked, not copied:
+  // iterators stay valid and each node goes back to its own pool
+  s21::list<int> foreign = {-2, -1};
+  auto moved = std::next(spare.begin(), 10);
+  address = &*moved;
+  foreign.splice(foreign.end(), spare);
+  EXPECT_NE(foreign.pool(), pool);
+  EXPECT_EQ(foreign.size(), 101u);
+  EXPECT_EQ(&*moved, address);
+  EXPECT_EQ(pool->in_use(), 100u);
+  EXPECT_EQ(foreign.pool()->in_use(), 2u);
+  foreign.erase(moved);
+  foreign.erase(foreign.begin());
+  EXPECT_EQ(pool->in_use(), 99u);
+  EXPECT_EQ(foreign.pool()->in_use(), 1u);
+  spare.splice(spare.begin(), foreign, foreign.begin());
+  EXPECT_EQ(spare.front(), -1);
+  spare.clear();
+  EXPECT_EQ(foreign.pool()->in_use(), 0u);
+  foreign.clear();
+  EXPECT_EQ(pool->in_use(), 1u);
+  s21::list<int> fresh;
+  fresh.splice(fresh.begin(), lru);
+  EXPECT_EQ(fresh.pool(), pool);
+
+  std::mt19937 gen(37);
+  std::uniform_int_distribution<int> dist(0, 500);
+  s21::list<std::pair<int, int>> items;
+  std::list<std::pair<int, int>> ref;
+  for (int i = 0; i < 3000; ++i) {
+    items.emplace_back(dist(gen), i);
+    ref.emplace_back(items.back());
+  }
+  auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+  items.sort(by_key);
+  ref.sort(by_key);
+  EXPECT_TRUE(std::equal(items.begin(), items.end(), ref.begin(), ref.end()));
+  EXPECT_EQ(items.pool()->in_use(), 3000u);
+}
+
+TEST(Queue, RingBuffer) {
+  s21::queue<std::string> q = {"a", "b"};
+  q.insert_many_back("c", "d");
+  EXPECT_EQ(q.front(), "a");
+  EXPECT_EQ(q.back(), "d");
+  q.pop();
+  q.push(q.front());
+  EXPECT_EQ(q.back(), "b");
+
+  // head wraps around while the queue keeps a steady size
+  s21::queue<int> ints;
+  for (int i = 0; i < 6; ++i) ints.push(i);
+  size_t capacity = ints.capacity();
+  for (int i = 6; i < 1000; ++i) {
+    EXPECT_EQ(ints.front(), i - 6);
+    ints.pop();
+    ints.push(i);
+  }
+  EXPECT_EQ(ints.capacity(), capacity);
+  for (int i = 1000; i < 1100; ++i) ints.emplace(i);
+  for (int i = 994; i < 1100; ++i) {
+    EXPECT_EQ(ints.front(), i);
+    ints.pop();
+  }
+  EXPECT_TRUE(ints.empty());
+
+  s21::queue<std::string> copy = q;
+  s21::queue<std::string> other;
+  other.swap(copy);
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(other.size(), 4u);
+  EXPECT_EQ(other.front(), "b");
+}
+
+TEST(Stack, RingBuffer) {
+  s21::stack<int> s = {1, 2};
+  s.insert_many_back(3, 4);
+  EXPECT_EQ(s.top(), 4);
+  EXPECT_EQ(s.size(), 4u);
+  for (int i = 5; i < 100; ++i) s.push(i);
+  for (int i = 99; i > 0; --i) {
+    EXPECT_EQ(s.top(), i);
+    s.pop();
+  }
+  EXPECT_TRUE(s.empty());
+  s.emplace(7);
+  s21::stack<int> moved(std::move(s));
+  EXPECT_EQ(moved.top(), 7);
+}
+
+TEST(SpscQueue, ProducerConsumerStress) {
+  s21::spsc_queue<std::unique_ptr<uint64_t>> q(100);
+  EXPECT_EQ(q.capacity(), 128u);
+  std::unique_ptr<uint64_t> value;
+  EXPECT_FALSE(q.try_pop(value));
+
+  const uint64_t n = 200000;
+  std::thread producer([&q] {
+    for (uint64_t i = 0; i < n; ++i) {
+      auto value = std::make_unique<uint64_t>(i);
+      while (!q.try_push(std::move(value))) std::this_thread::yield();
+    }
+  });
+  uint64_t expected = 0;
+  bool in_order = true;
+  while (expected < n) {
+    if (q.try_pop(value)) {
+      in_order = in_order && *value == expected;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(q.empty_approx());
+
+  s21::spsc_queue<std::string> left(2);
+  EXPECT_TRUE(left.try_emplace(3, 'x'));
+  EXPECT_TRUE(left.try_push("y"));
+  EXPECT_FALSE(left.try_push("z"));
+  EXPECT_EQ(left.size_approx(), 2u);
+}
+
+TEST(UnorderedSet, Basics) {
+  s21::unordered_set<int> a{5, 1, 3, 1};
+  EXPECT_EQ(a.size(), 3u);
+  EXPECT_TRUE(a.contains(3));
+  EXPECT_FALSE(a.contains(2));
+  EXPECT_EQ(a.count(5), 1u);
+  EXPECT_EQ(*a.find(1), 1);
+  EXPECT_EQ(a.find(7), a.end());
+  EXPECT_FALSE(a.insert(5).second);
+  EXPECT_TRUE(a.insert(7).second);
+  EXPECT_EQ(a.erase(1), 1u);
+  EXPECT_EQ(a.erase(1), 0u);
+
+  auto res = a.insert_many(9, 3, 11);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_EQ(*res[0].first, 9);
+  EXPECT_EQ(*res[2].first, 11);
+
+  auto nh = a.extract(9);
+  EXPECT_EQ(nh.value(), 9);
+  EXPECT_FALSE(a.contains(9));
+  auto back = a.insert(std::move(nh));
+  EXPECT_TRUE(back.inserted);
+  EXPECT_TRUE(nh.empty());
+
+  s21::unordered_set<int> b{3, 4};
+  a.merge(b);
+  EXPECT_TRUE(a.contains(4));
+  EXPECT_EQ(b.size(), 1u);
+  EXPECT_TRUE(a.validate());
+
+  int sum = 0;
+  for (auto it = a.begin(); it != a.end();) {
+    sum += *it;
+    it = *it % 2 ? a.erase(it) : ++it;
+  }
+  EXPECT_EQ(sum, 3 + 4 + 5 + 7 + 9 + 11);
+  EXPECT_EQ(a.size(), 1u);
+  EXPECT_TRUE(a.contains(4));
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.begin(), a.end());
+
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const {
+      return std::hash<std::string_view>()(s);
+    }
+  };
+  s21::unordered_set<std::string, StringHash, std::equal_to<>> words{
+      "alpha", "beta"};
+  EXPECT_TRUE(words.contains(std::string_view("beta")));
+  EXPECT_TRUE(words.contains("alpha"));
+  EXPECT_EQ(words.find("gamma"), words.end());
+}
+
+TEST(UnorderedSet, RobinHoodAgainstStd) {
+  // the identity hash with strided keys piles probe runs up on purpose
+  std::mt19937 gen(7);
+  s21::unordered_set<uint32_t> ours;
+  std::unordered_set<uint32_t> ref;
+  for (int i = 0; i < 60000; ++i) {
+    uint32_t key = (gen() % 20000) * 64;
+    if (gen() % 3) {
+      EXPECT_EQ(ours.insert(key).second, ref.insert(key).second);
+    } else {
+      EXPECT_EQ(ours.erase(key), ref.erase(key));
+    }
+  }
+  EXPECT_TRUE(ours.validate());
+  EXPECT_EQ(ours.size(), ref.size());
+  EXPECT_LE(ours.load_factor(), ours.max_load_factor());
+  size_t seen = 0;
+  for (uint32_t key : ours) {
+    seen += ref.count(key);
+  }
+  EXPECT_EQ(seen, ref.size());
+
+  s21::unordered_set<uint32_t> copy = ours;
+  copy.rehash(8);
+  EXPECT_TRUE(copy.validate());
+  EXPECT_EQ(copy.size(), ours.size());
+  copy.reserve(100000);
+  EXPECT_GE(copy.bucket_count(), 125000u);
+  for (uint32_t key : ref) {
+    EXPECT_TRUE(copy.contains(key));
+  }
+
+  s21::unordered_set<std::string> strings;
+  for (int i = 0; i < 1000; ++i) {
+    strings.emplace(std::to_string(i));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    strings.erase(std::to_string(i));
+  }
+  EXPECT_TRUE(strings.validate());
+  EXPECT_EQ(strings.size(), 500u);
+  EXPECT_TRUE(strings.contains("999"));
+  EXPECT_FALSE(strings.contains("998"));
+}
+
+struct ThousandsHash {
+  size_t operator()(int x) const { return x / 1000; }
+};
+
+TEST(UnorderedSet, CollidingHashFailsFast) {
+  // 255 keys with one hash fill a probe run, growing cannot split it
+  s21::unordered_set<int, ThousandsHash> s;
+  for (int i = 0; i < 255; ++i) {
+    s.insert(i);
+  }
+  EXPECT_THROW(s.insert(255), std::length_error);
+  EXPECT_EQ(s.size(), 255u);
+  EXPECT_LE(s.bucket_count(), 1024u);
+  EXPECT_TRUE(s.validate());
+
+  // runs of a couple hundred colliding keys still fit next to other keys
+  s21::unordered_set<int, ThousandsHash> mixed;
+  for (int i = 0; i < 200000; i += 5) {
+    mixed.insert(i);
+  }
+  EXPECT_EQ(mixed.size(), 40000u);
+  EXPECT_TRUE(mixed.contains(199995));
+  EXPECT_TRUE(mixed.validate());
+}
+
+// throws once calls_left calls have been made, none when it is negative
+struct FlakyHash {
+  static inline int calls_left = -1;
+  size_t operator()(int x) const {
+    if (calls_left == 0) {
+      throw std::runtime_error("hash");
+    }
+    calls_left -= calls_left > 0;
+    return std::hash<int>()(x);
+  }
+};
+
+struct FragileKeyHash {
+  size_t operator()(const FragileKey &key) const { return key.value; }
+};
+
+TEST(UnorderedSet, RehashThrowKeepsKeys) {
+  s21::unordered_set<int, FlakyHash> s;
+  for (int i = 0; i < 100; ++i) {
+    s.insert(i);
+  }
+  FlakyHash::calls_left = 50;
+  EXPECT_THROW(s.rehash(1024), std::runtime_error);
+  FlakyHash::calls_left = -1;
+  EXPECT_EQ(s.size(), 100u);
+  EXPECT_TRUE(s.validate());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(s.contains(i));
+  }
+
+  s21::unordered_multiset<FragileKey, FragileKeyHash> m;
+  for (int i = 0; i < 100; ++i) {
+    m.insert(i % 40);
+  }
+  FragileKey::copies_left = 50;
+  EXPECT_THROW(m.rehash(1024), std::runtime_error);
+  FragileKey::copies_left = -1;
+  EXPECT_EQ(m.size(), 100u);
+  EXPECT_TRUE(m.validate());
+  EXPECT_EQ(m.count(0), 3u);
+  EXPECT_EQ(m.count(39), 2u);
+  m.rehash(1024);
+  EXPECT_EQ(m.bucket_count(), 1024u);
+  EXPECT_EQ(m.count(0), 3u);
+  EXPECT_TRUE(m.validate());
+}
+
+TEST(UnorderedMultiset, Basics) {
+  s21::unordered_multiset<int> a{2, 1, 2, 3, 2};
+  EXPECT_EQ(a.size(), 5u);
+  EXPECT_EQ(a.count(2), 3u);
+  EXPECT_EQ(a.count(4), 0u);
+  auto range = a.equal_range(2);
+  int n = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    EXPECT_EQ(*it, 2);
+    ++n;
+  }
+  EXPECT_EQ(n, 3);
+
+  auto res = a.insert_many(1, 5);
+  EXPECT_EQ(*res[0].first, 1);
+  EXPECT_EQ(a.count(1), 2u);
+  EXPECT_EQ(a.erase(2), 3u);
+  EXPECT_FALSE(a.contains(2));
+  EXPECT_TRUE(a.validate());
+
+  s21::unordered_multiset<int> b{1, 1};
+  a.merge(b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a.count(1), 4u);
+
+  for (int i = 0; i < 4; ++i) {
+    a.insert(42);
+  }
+  for (int i = 0; i < 10000; ++i) {
+    a.insert(i * 8);
+  }
+  EXPECT_EQ(a.count(42), 4u);
+  EXPECT_EQ(a.count(0), 1u);
+  EXPECT_TRUE(a.validate());
+
+  s21::unordered_multiset<int> many;
+  for (int i = 0; i < 128; ++i) {
+    many.insert(7);
+  }
+  EXPECT_THROW(many.insert(7), std::length_error);
+  EXPECT_EQ(many.count(7), 128u);
+}
+
+TEST(SetViews, RangeAndAlgebra) {
+  static_assert(std::bidirectional_iterator<s21::set<int>::iterator>);
+  static_assert(
+      std::bidirectional_iterator<s21::multiset<int>::const_iterator>);
+  auto collect = [](auto &&view) {
+    std::vector<int> res;
+    for (int key : view) {
+      res.push_back(key);
+    }
+    return res;
+  };
+
+  s21::set<int> evens;
+  s21::set<int> threes;
+  std::vector<int> evens_ref;
+  std::vector<int> threes_ref;
+  for (int i = 0; i < 300; ++i) {
+    if (i % 2 == 0) {
+      evens.insert(i);
+      evens_ref.push_back(i);
+    }
+    if (i % 3 == 0) {
+      threes.insert(i);
+      threes_ref.push_back(i);
+    }
+  }
+
+  auto r = s21::range(evens, 10, 19);
+  EXPECT_EQ(collect(r), (std::vector<int>{10, 12, 14, 16, 18}));
+  EXPECT_EQ(std::ranges::distance(r), 5);
+  EXPECT_TRUE(s21::range(evens, 20, 10).empty());
+  EXPECT_EQ(*std::prev(r.end()), 18);
+
+  std::vector<int> expected;
+  std::set_union(evens_ref.begin(), evens_ref.end(), threes_ref.begin(),
+                 threes_ref.end(), std::back_inserter(expected));
+  s21::union_view u(evens, threes);
+  static_assert(std::ranges::view<decltype(u)>);
+  static_assert(std::ranges::forward_range<decltype(u)>);
+  EXPECT_EQ(collect(u), expected);
+
+  expected.clear();
+  std::set_intersection(evens_ref.begin(), evens_ref.end(),
+                        threes_ref.begin(), threes_ref.end(),
+                        std::back_inserter(expected));
+  EXPECT_EQ(collect(s21::intersection_view(evens, threes)), expected);
+  EXPECT_EQ(collect(s21::intersection_view(threes, evens)), expected);
+
+  expected.clear();
+  std::set_difference(evens_ref.begin(), evens_ref.end(), threes_ref.begin(),
+                      threes_ref.end(), std::back_inserter(expected));
+  EXPECT_EQ(collect(s21::difference_view(evens, threes)), expected);
+  EXPECT_EQ(collect(s21::difference_view(evens, threes) |
+                    std::views::take(3)),
+            (std::vector<int>{2, 4, 8}));
+
+  // a few keys against many: the big side skips through lower_bound
+  s21::set<int> few{-5, 4, 150, 299, 1000};
+  EXPECT_EQ(collect(s21::intersection_view(few, evens)),
+            (std::vector<int>{4, 150}));
+  EXPECT_EQ(collect(s21::intersection_view(threes, few)),
+            (std::vector<int>{150}));
+  EXPECT_EQ(collect(s21::difference_view(few, evens)),
+            (std::vector<int>{-5, 299, 1000}));
+  s21::set<int> none;
+  EXPECT_TRUE(s21::intersection_view(none, evens).empty());
+  EXPECT_EQ(collect(s21::union_view(none, few)), collect(few));
+
+  s21::multiset<int> m1{1, 1, 1, 2};
+  s21::multiset<int> m2{1, 1, 3};
+  EXPECT_EQ(collect(s21::union_view(m1, m2)),
+            (std::vector<int>{1, 1, 1, 2, 3}));
+  EXPECT_EQ(collect(s21::intersection_view(m1, m2)),
+            (std::vector<int>{1, 1}));
+  EXPECT_EQ(collect(s21::difference_view(m1, m2)), (std::vector<int>{1, 2}));
+  EXPECT_EQ(collect(s21::range(m1, 1, 2)), (std::vector<int>{1, 1, 1}));
+}
+
+TEST(FingerSearch, MatchesRootSearch) {
+  std::mt19937 gen(11);
+  s21::multiset<int> ms;
+  s21::set<int> s;
+  for (int i = 0; i < 3000; ++i) {
+    int key = static_cast<int>(gen() % 5000) * 2;
+    ms.insert(key);
+    s.insert(key);
+  }
+  std::vector<s21::multiset<int>::iterator> fingers;
+  for (auto it = ms.begin(); it != ms.end(); ++it) {
+    if (gen() % 50 == 0) {
+      fingers.push_back(it);
+    }
+  }
+  fingers.push_back(ms.end());
+  for (auto finger : fingers) {
+    for (int i = 0; i < 50; ++i) {
+      int key = static_cast<int>(gen() % 10010) - 5;
+      EXPECT_EQ(ms.lower_bound_from(finger, key), ms.lower_bound(key));
+      EXPECT_EQ(ms.find_from(finger, key), ms.lower_bound(key) != ms.end() &&
+                                                   *ms.lower_bound(key) == key
+                                               ? ms.lower_bound(key)
+                                               : ms.end());
+    }
+  }
+
+  // a stream of nearby keys, each searched from the previous answer
+  auto finger = s.begin();
+  for (int key = 0; key < 10000; key += 3) {
+    auto it = s.lower_bound_from(finger, key);
+    ASSERT_EQ(it, s.lower_bound(key));
+    EXPECT_EQ(s.find_from(finger, key) != s.end(), s.contains(key));
+    if (it != s.end()) {
+      finger = it;
+    }
+  }
+  if constexpr (s21::DefaultTreeStats::kEnabled) {
+    s21::set<int> big;
+    for (int i = 0; i < 100000; ++i) {
+      big.insert(i);
+    }
+    big.reset_stats();
+    auto it = big.find(50000);
+    for (int i = 50001; i < 51000; ++i) {
+      it = big.find_from(it, i);
+    }
+    // the next key is one step away, a root descent would take ~17
+    EXPECT_LT(big.stats().average_depth(), 8.0);
+  }
+}
+
+TEST(ConstApi, ReadThroughConstReference) {
+  s21::set<int> s{5, 1, 3};
+  const s21::set<int> &cs = s;
+  static_assert(std::is_same_v<decltype(cs.begin()),
+                               s21::set<int>::const_iterator>);
+  static_assert(std::is_same_v<decltype(cs.find(1)),
+                               s21::set<int>::const_iterator>);
+  s21::set<int>::const_iterator it = s.begin();
+  EXPECT_EQ(it, cs.cbegin());
+  EXPECT_EQ(s.begin(), cs.begin());
+  EXPECT_EQ(cs.size(), 3u);
+  EXPECT_FALSE(cs.empty());
+  EXPECT_TRUE(cs.contains(3));
+  EXPECT_EQ(cs.count(4), 0u);
+  EXPECT_EQ(*cs.find(5), 5);
+  EXPECT_EQ(cs.find(2), cs.end());
+  EXPECT_EQ(*cs.lower_bound(2), 3);
+  EXPECT_EQ(cs.upper_bound(5), cs.cend());
+  EXPECT_EQ(*cs.lower_bound_from(cs.begin(), 4), 5);
+  EXPECT_EQ(std::vector<int>(cs.rbegin(), cs.rend()),
+            (std::vector<int>{5, 3, 1}));
+  EXPECT_EQ(std::vector<int>(s.rbegin(), s.rend()),
+            (std::vector<int>{5, 3, 1}));
+  EXPECT_EQ(std::vector<int>(cs.crbegin(), cs.crend()),
+            (std::vector<int>{5, 3, 1}));
+
+  s21::multiset<int> ms{2, 1, 2};
+  const auto &cms = ms;
+  EXPECT_EQ(cms.count(2), 2u);
+  auto range = cms.equal_range(2);
+  EXPECT_EQ(std::distance(range.first, range.second), 2);
+  EXPECT_EQ(*cms.rbegin(), 2);
+  EXPECT_EQ(*cms.find(1), 1);
+
+  s21::map<int, char> m{{1, 'a'}, {2, 'b'}};
+  const auto &cm = m;
+  EXPECT_EQ(cm.find(2)->second, 'b');
+  EXPECT_EQ(cm.at(1), 'a');
+  EXPECT_EQ(cm.size(), 2u);
+  EXPECT_EQ(cm.rbegin()->first, 2);
+  s21::multimap<int, char> mm{{1, 'a'}, {1, 'b'}};
+  const auto &cmm = mm;
+  EXPECT_EQ(cmm.count(1), 2u);
+  EXPECT_EQ(cmm.find(1)->second, 'a');
+  s21::interval_set<int> is{{1, 5}, {3, 4}};
+  const auto &cis = is;
+  EXPECT_EQ(cis.size(), 2u);
+  EXPECT_TRUE(cis.contains({3, 4}));
+
+  const s21::set<int> other{3, 4};
+  std::vector<int> both;
+  for (int key : s21::intersection_view(cs, other)) {
+    both.push_back(key);
+  }
+  EXPECT_EQ(both, std::vector<int>{3});
+  EXPECT_EQ(std::ranges::distance(s21::range(cs, 1, 4)), 2);
+}
+
+// readers share one set through const& without locks; run it under
+// -fsanitize=thread to check for races
+TEST(ConstApi, ConcurrentReaders) {
+  if constexpr (s21::DefaultTreeStats::kEnabled) {
+    GTEST_SKIP() << "stats builds count into the tree on every read";
+  }
+  s21::set<int> s;
+  for (int i = 0; i < 20000; ++i) {
+    s.insert(i * 2);
+  }
+  auto reader = [](const s21::set<int> &shared, int seed, size_t *hits) {
+    std::mt19937 gen(seed);
+    size_t n = 0;
+    for (int i = 0; i < 20000; ++i) {
+      int key = static_cast<int>(gen() % 40000);
+      n += shared.contains(key);
+      auto it = shared.lower_bound(key);
+      if (it != shared.end() && *it == key) {
+        ++n;
+      }
+    }
+    for (auto it = shared.rbegin(); it != shared.rend(); ++it) {
+      n += *it == 0;
+    }
+    *hits = n + shared.size();
+  };
+  size_t hits[4] = {};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back(reader, std::cref(s), t, &hits[t]);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < 4; ++t) {
+    size_t expected = 0;
+    reader(s, t, &expected);
+    EXPECT_EQ(hits[t], expected);
+  }
+}
+
+TEST(CachedSet, HotKeysHitTheCache) {
+  s21::cached_set<int> s(64);
+  EXPECT_EQ(s.cache_slots(), 64u);
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i);
+  }
+  for (int round = 0; round < 10; ++round) {
+    for (int key = 0; key < 8; ++key) {
+      EXPECT_EQ(*s.find(key), key);
+    }
+  }
+  EXPECT_GE(s.cache_stats().hits, 60u);
+  EXPECT_FALSE(s.contains(5000));
+  EXPECT_TRUE(s.validate());
+
+  // erasing drops the cached node, the next lookup must not see it
+  EXPECT_TRUE(s.contains(3));
+  EXPECT_EQ(s.erase(3), 1u);
+  EXPECT_FALSE(s.contains(3));
+  EXPECT_EQ(s.erase(3), 0u);
+  auto nh = s.extract(s.find(4));
+  EXPECT_EQ(nh.value(), 4);
+  EXPECT_FALSE(s.contains(4));
+  EXPECT_TRUE(s.validate());
+
+  s21::cached_set<int> moved(std::move(s));
+  auto it = moved.find(5);
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(*std::prev(moved.end()), 999);
+  EXPECT_EQ(moved.size(), 998u);
+  // the moved-from set is usable again, with a cache of its own
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.cache_slots(), 64u);
+  s.insert(5);
+  EXPECT_TRUE(s.contains(5));
+  s = std::move(moved);
+  EXPECT_TRUE(moved.empty());
+  moved.insert(5);
+  EXPECT_TRUE(moved.contains(5));
+  std::swap(s, moved);
+
+  s21::cached_set<int> copy = moved;
+  EXPECT_TRUE(copy.contains(7));
+  copy.erase(copy.find(7));
+  EXPECT_TRUE(moved.contains(7));
+
+  s21::cached_set<int> other{8, 2000};
+  EXPECT_TRUE(other.contains(2000));
+  copy.merge(other);
+  EXPECT_TRUE(copy.contains(2000));
+  EXPECT_FALSE(other.contains(2000));
+  EXPECT_TRUE(other.contains(8));
+  EXPECT_TRUE(copy.validate());
+  EXPECT_TRUE(other.validate());
+
+  copy.clear();
+  EXPECT_FALSE(copy.contains(5));
+  EXPECT_GT(moved.cache_stats().hit_rate(), 0.5);
+}
+
+TEST(FilteredSet, RejectsMisses) {
+  s21::filtered_set<int> s;
+  for (int i = 0; i < 10000; ++i) {
+    s.insert(2 * i);
+  }
+  EXPECT_TRUE(s.validate());
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(s.contains(2 * i));
+    ASSERT_FALSE(s.contains(2 * i + 1));
+  }
+  auto stats = s.filter_stats();
+  EXPECT_EQ(stats.queries, 20000u);
+  EXPECT_EQ(stats.rejected + stats.false_positives, 10000u);
+  EXPECT_LT(stats.false_positive_rate(), 0.03);
+  EXPECT_GT(stats.memory_bytes, 0u);
+
+  // erased keys still set bits until enough of them force a rebuild
+  for (int i = 0; i < 8000; ++i) {
+    ASSERT_EQ(s.erase(2 * i), 1u);
+  }
+  EXPECT_EQ(s.size(), 2000u);
+  EXPECT_FALSE(s.contains(0));
+  EXPECT_TRUE(s.contains(19998));
+  EXPECT_TRUE(s.validate());
+
+  s.freeze();
+  EXPECT_TRUE(s.frozen());
+  EXPECT_TRUE(s.validate());
+  s.reset_filter_stats();
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_EQ(s.contains(2 * i), i >= 8000);
+    ASSERT_FALSE(s.contains(2 * i + 1));
+  }
+  stats = s.filter_stats();
+  EXPECT_LT(stats.false_positive_rate(), 0.02);
+  EXPECT_LT(stats.bits_per_key, 11.0);
+
+  // erase keeps the xor filter, insert thaws it
+  s.erase(s.find(19998));
+  EXPECT_TRUE(s.frozen());
+  EXPECT_FALSE(s.contains(19998));
+  EXPECT_TRUE(s.insert(1).second);
+  EXPECT_FALSE(s.frozen());
+  EXPECT_TRUE(s.contains(1));
+  EXPECT_TRUE(s.validate());
+
+  s21::filtered_set<int> other{1, 5, 7};
+  other.freeze();
+  s.merge(other);
+  EXPECT_TRUE(s.contains(5));
+  EXPECT_TRUE(s.contains(7));
+  EXPECT_TRUE(other.contains(1));
+  EXPECT_FALSE(other.contains(5));
+  EXPECT_EQ(other.size(), 1u);
+  EXPECT_EQ(s.size(), s.base().size());
+  EXPECT_TRUE(s.validate());
+  EXPECT_TRUE(other.validate());
+
+  // a moved-from set starts over empty
+  s21::filtered_set<int> moved(std::move(other));
+  EXPECT_TRUE(moved.contains(1));
+  EXPECT_EQ(other.size(), 0u);
+  auto res = other.insert_many(4, 4, 6);
+  static_assert(decltype(res)::inline_capacity == 3);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_TRUE(other.contains(6));
+  EXPECT_EQ(other.size(), 2u);
+  moved = std::move(other);
+  EXPECT_EQ(moved.size(), 2u);
+  EXPECT_TRUE(other.empty());
+  EXPECT_TRUE(other.insert(9).second);
+  EXPECT_TRUE(other.contains(9));
+  EXPECT_TRUE(other.validate());
+  EXPECT_TRUE(moved.validate());
+
+  s.clear();
+  EXPECT_FALSE(s.contains(5));
+  s.freeze();
+  EXPECT_FALSE(s.contains(5));
+  EXPECT_TRUE(s.validate());
+}
+
+// monotonic arena that counts what the containers hand back to it
+class CountingArena : public std::pmr::monotonic_buffer_resource {
+ public:
+  using std::pmr::monotonic_buffer_resource::monotonic_buffer_resource;
+  size_t allocations = 0;
+  size_t deallocations = 0;
+
+ protected:
+  void *do_allocate(size_t bytes, size_t align) override {
+    ++allocations;
+    return monotonic_buffer_resource::do_allocate(bytes, align);
+  }
+  void do_deallocate(void *p, size_t bytes, size_t align) override {
+    ++deallocations;
+    monotonic_buffer_resource::do_deallocate(p, bytes, align);
+  }
+};
+
+TEST(ArenaSet, AllocatesFromResourceAndSkipsTeardown) {
+  CountingArena arena;
+  {
+    s21::set<int> s(&arena);
+    EXPECT_EQ(s.resource(), &arena);
+    for (int i = 0; i < 1000; ++i) {
+      s.insert(i);
+    }
+    EXPECT_EQ(arena.allocations, 1000u);
+    EXPECT_TRUE(s.validate());
+    s.erase(s.find(5));
+    EXPECT_EQ(arena.deallocations, 1u);
+
+    // nodes crossing to a heap set are copied out of the arena and back
+    s21::set<int> heap{5, 2000};
+    EXPECT_EQ(heap.resource(), nullptr);
+    heap.insert(s.extract(7));
+    EXPECT_TRUE(heap.contains(7));
+    s.merge(heap);
+    EXPECT_TRUE(s.contains(2000));
+    EXPECT_TRUE(s.contains(7));
+    EXPECT_TRUE(s.validate());
+
+    s21::set<int> copy = s;
+    EXPECT_EQ(copy.resource(), nullptr);
+    EXPECT_EQ(copy.size(), s.size());
+    s21::set<int> moved = std::move(s);
+    EXPECT_EQ(moved.resource(), &arena);
+    moved.swap(heap);
+    EXPECT_EQ(heap.resource(), &arena);
+    EXPECT_EQ(moved.resource(), nullptr);
+    EXPECT_EQ(heap.size(), 1001u);
+  }
+  // the int nodes were left to the arena, not freed one by one
+  EXPECT_EQ(arena.deallocations, 2u);
+  arena.release();
+
+  {
+    s21::multiset<std::string> ms(&arena);
+    ms.insert(std::string(64, 'a'));
+    ms.insert(std::string(64, 'a'));
+    ms.insert("b");
+    EXPECT_EQ(ms.count(std::string(64, 'a')), 2u);
+    s21::multiset<std::string> heap;
+    heap.insert(ms.extract(ms.find("b")));
+    EXPECT_EQ(heap.size(), 1u);
+    ms.merge(heap);
+    EXPECT_EQ(ms.size(), 3u);
+    EXPECT_TRUE(heap.empty());
+    arena.deallocations = 0;
+  }
+  // strings need their destructors, so these nodes are walked and freed
+  EXPECT_EQ(arena.deallocations, 3u);
+}
+
+TEST(LookupMany, MatchesFind) {
+  s21::set<int> s;
+  std::vector<int> keys;
+  std::mt19937 gen(11);
+  for (int i = 0; i < 5000; ++i) {
+    s.insert(3 * i);
+  }
+  for (int i = 0; i < 20000; ++i) {
+    keys.push_back(static_cast<int>(gen() % 16000));
+  }
+  for (size_t width : {1, 4, 16, 64}) {
+    auto found = s.lookup_many(keys, width);
+    ASSERT_EQ(found.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      ASSERT_EQ(found[i], std::as_const(s).find(keys[i]));
+    }
+  }
+  EXPECT_TRUE(s21::set<int>().lookup_many(keys).front() ==
+              s21::set<int>().end());
+  EXPECT_TRUE(s.lookup_many({}).empty());
+
+  s21::multiset<std::string> ms{"b", "a", "b", "c"};
+  std::vector<std::string> words{"b", "x", "a", "b", "0"};
+  auto found = ms.lookup_many(words, 3);
+  EXPECT_EQ(found[0], ms.lower_bound("b"));
+  EXPECT_EQ(found[1], ms.end());
+  EXPECT_EQ(*found[2], "a");
+  EXPECT_EQ(found[3], found[0]);
+  EXPECT_EQ(found[4], ms.end());
+}
+
+TEST(ShardedSet, RangesFollowTheKeys) {
+  s21::sharded_set<int, 8> s;
+  std::set<int> expected;
+  // ascending keys all land in the last shard until it is rebalanced
+  for (int i = 0; i < 20000; ++i) {
+    EXPECT_TRUE(s.insert(i * 3));
+    expected.insert(i * 3);
+  }
+  EXPECT_FALSE(s.insert(300));
+  EXPECT_EQ(s.size(), 20000u);
+  EXPECT_EQ(s.splits().size(), 7u);
+  for (size_t n : s.shard_sizes()) {
+    EXPECT_LT(n, 20000u / 8 * 3);
+  }
+  EXPECT_TRUE(s.validate());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(),
+                         expected.end()));
+
+  for (int key : {-5, 0, 1, 3000, 29999, 59997, 59998}) {
+    auto it = s.lower_bound(key);
+    auto want = expected.lower_bound(key);
+    if (want == expected.end()) {
+      EXPECT_EQ(it, s.end());
+    } else {
+      EXPECT_EQ(*it, *want);
+    }
+  }
+  for (int i = 0; i < 20000; i += 2) {
+    EXPECT_EQ(s.erase(i * 3), 1u);
+    expected.erase(i * 3);
+  }
+  EXPECT_EQ(s.erase(0), 0u);
+  EXPECT_FALSE(s.contains(6));
+  EXPECT_TRUE(s.contains(9));
+  s.rebalance();
+  EXPECT_TRUE(s.validate());
+  EXPECT_TRUE(std::equal(s.begin(), s.end(), expected.begin(),
+                         expected.end()));
+  s.clear();
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.begin(), s.end());
+}
+
+TEST(ShardedSet, ConcurrentAndBulkInserts) {
+  if constexpr (s21::DefaultTreeStats::kEnabled) {
+    GTEST_SKIP() << "stats builds count into the tree on every read";
+  }
+  s21::sharded_set<int, 4> s;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 4; ++t) {
+    writers.emplace_back([&s, t] {
+      for (int i = 0; i < 5000; ++i) {
+        s.insert(i * 4 + t);
+        s.contains(i * 4);
+      }
+    });
+  }
+  for (auto &w : writers) {
+    w.join();
+  }
+  EXPECT_EQ(s.size(), 20000u);
+  EXPECT_TRUE(s.validate());
+  EXPECT_TRUE(std::is_sorted(s.begin(), s.end()));
+
+  s21::sharded_set<int, 4> bulk;
+  std::vector<int> keys(40000);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+  EXPECT_EQ(bulk.insert_bulk(std::span(keys).first(30000), 4), 30000u);
+  for (size_t n : bulk.shard_sizes()) {
+    EXPECT_GT(n, 30000u / 4 / 2);
+  }
+  EXPECT_EQ(bulk.insert_bulk(keys, 3), 10000u);
+  EXPECT_EQ(bulk.size(), 40000u);
+  EXPECT_TRUE(bulk.validate());
+  EXPECT_EQ(*bulk.begin(), 0);
+  EXPECT_EQ(std::distance(bulk.begin(), bulk.end()), 40000);
+}
+
+TEST(StaticSet, BuiltAtCompileTime) {
+  using namespace std::string_view_literals;
+  constexpr s21::static_set kReserved{"while"sv, "for"sv, "if"sv, "else"sv,
+                                      "return"sv, "if"sv};
+  static_assert(kReserved.size() == 5);
+  static_assert(kReserved.contains("return"sv));
+  static_assert(!kReserved.contains("goto"sv));
+  static_assert(*kReserved.begin() == "else"sv);
+  static_assert(*kReserved.lower_bound("g"sv) == "if"sv);
+  static_assert(kReserved.upper_bound("while"sv) == kReserved.end());
+  EXPECT_TRUE(std::is_sorted(kReserved.begin(), kReserved.end()));
+
+  constexpr auto kOdd = [] {
+    std::array<int, 301> keys{};
+    for (int i = 0; i < 301; ++i) {
+      keys[i] = (i * 7919) % 301 * 2 + 1;
+    }
+    return s21::static_set<int, 301>(keys);
+  }();
+  std::set<int> model(kOdd.begin(), kOdd.end());
+  ASSERT_EQ(kOdd.size(), 301u);
+  for (int key = -1; key <= 604; ++key) {
+    auto pos = [&](auto it) { return it - kOdd.begin(); };
+    EXPECT_EQ(kOdd.contains(key), model.count(key) == 1);
+    EXPECT_EQ(pos(kOdd.lower_bound(key)),
+              std::distance(model.begin(), model.lower_bound(key)));
+    EXPECT_EQ(pos(kOdd.upper_bound(key)),
+              std::distance(model.begin(), model.upper_bound(key)));
+  }
+
+  constexpr s21::static_set<int, 4, std::greater<int>> kDown{{1, 4, 2, 3}};
+  static_assert(*kDown.begin() == 4 && *kDown.lower_bound(2) == 2);
+  static_assert(kDown.lower_bound(0) == kDown.end());
+  static_assert(s21::static_set<int, 0>().lower_bound(1) ==
+                s21::static_set<int, 0>().end());
+
+  constexpr s21::static_set<int, 6> kFew(3, 1, 2);
+  static_assert(kFew.size() == 3 && kFew.max_size() == 6);
+  static_assert(!kFew.contains(0) && kFew.contains(3));
+  static_assert(*kFew.begin() == 1 && kFew.lower_bound(4) == kFew.end());
+  constexpr s21::static_set<int, 6> kFewArray(std::array<int, 2>{5, 0});
+  static_assert(kFewArray.size() == 2 && *kFewArray.begin() == 0);
+  constexpr s21::static_set<int, 6> kFewList({9, 8});
+  static_assert(kFewList.size() == 2 && !kFewList.contains(0));
+}
+
+TEST(Reclaimer, FreesClearedTreesInSlices) {
+  s21::reclaimer background(s21::reclaimer::mode::background, {1000});
+  {
+    s21::set<int> s;
+    s.reclaim_with(&background);
+    for (int i = 0; i < 100000; ++i) {
+      s.insert(i);
+    }
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    s.insert(7);
+    s = s21::set<int>{1, 2, 3};
+    EXPECT_TRUE(s.validate());
+  }
+  background.wait();
+  EXPECT_EQ(background.pending(), 0u);
+  EXPECT_EQ(background.freed(), 100004u);
+
+  // in assist mode every allocation frees a slice of at most 64 steps
+  s21::reclaimer assist(s21::reclaimer::mode::assist, {64});
+  s21::multiset<int> ms;
+  ms.reclaim_with(&assist);
+  for (int i = 0; i < 10000; ++i) {
+    ms.insert(i % 100);
+  }
+  ms.clear();
+  EXPECT_EQ(assist.pending(), 1u);
+  EXPECT_EQ(assist.freed(), 0u);
+  for (int i = 0; i < 10; ++i) {
+    ms.insert(i);
+  }
+  EXPECT_GT(assist.freed(), 0u);
+  EXPECT_LE(assist.freed(), 640u);
+  EXPECT_EQ(assist.pending(), 1u);
+  assist.wait();
+  EXPECT_EQ(assist.pending(), 0u);
+  EXPECT_EQ(assist.freed(), 10000u);
+  EXPECT_EQ(ms.size(), 10u);
+  EXPECT_TRUE(ms.validate());
+
+  // a reclaimer going first detaches its trees, they free in place again
+  s21::set<int> outliving;
+  s21::multiset<int> swapped;
+  {
+    s21::reclaimer short_lived;
+    outliving.reclaim_with(&short_lived);
+    for (int i = 0; i < 1000; ++i) {
+      outliving.insert(i);
+    }
+    s21::set<int> taken(std::move(outliving));
+    outliving.swap(taken);
+    EXPECT_EQ(outliving.size(), 1000u);
+    swapped.swap(ms);
+    EXPECT_EQ(swapped.size(), 10u);
+  }
+  outliving.clear();
+  outliving.insert(1);
+  EXPECT_TRUE(outliving.validate());
+  swapped.clear();
+  EXPECT_EQ(assist.pending(), 0u);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
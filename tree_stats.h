@@ -0,0 +1,96 @@
+#ifndef TREE_STATS_H
+#define TREE_STATS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace s21 {
+// counters collected by RBTree when it is built with CountingTreeStats
+struct TreeStats {
+  size_t comparisons = 0;
+  size_t rotations = 0;
+  size_t recolorings = 0;
+  size_t allocations = 0;
+  size_t frees = 0;
+  // descents made by lookups and insertions and the depth they reached
+  size_t lookups = 0;
+  size_t total_depth = 0;
+  size_t max_depth = 0;
+
+  double average_depth() const {
+    return lookups ? static_cast<double>(total_depth) / lookups : 0.0;
+  }
+};
+
+// the default policy: every hook is empty and the tree carries no state
+struct NoTreeStats {
+  static constexpr bool kEnabled = false;
+
+  void OnCompare() const {}
+  void OnRotate() const {}
+  void OnRecolor(size_t) const {}
+  void OnAllocate() const {}
+  void OnFree() const {}
+  void OnLookup(size_t) const {}
+
+  TreeStats Snapshot() const { return TreeStats(); }
+  void Reset() const {}
+};
+
+// Plain counters, updated from const lookups too, so a tree that collects
+// stats must not be read from several threads at once.
+class CountingTreeStats {
+ public:
+  static constexpr bool kEnabled = true;
+
+  void OnCompare() const { ++stats_.comparisons; }
+  void OnRotate() const { ++stats_.rotations; }
+  void OnRecolor(size_t cnt) const { stats_.recolorings += cnt; }
+  void OnAllocate() const { ++stats_.allocations; }
+  void OnFree() const { ++stats_.frees; }
+  void OnLookup(size_t depth) const {
+    ++stats_.lookups;
+    stats_.total_depth += depth;
+    if (depth > stats_.max_depth) {
+      stats_.max_depth = depth;
+    }
+  }
+
+  TreeStats Snapshot() const { return stats_; }
+  void Reset() const { stats_ = TreeStats(); }
+
+ private:
+  mutable TreeStats stats_;
+};
+
+// shape and memory footprint of a tree, see RBTree::Inspect
+struct TreeShape {
+  size_t size = 0;
+  // longest root-to-leaf path in nodes and black nodes on every such path
+  size_t height = 0;
+  size_t black_height = 0;
+  // number of nodes at every depth, the root is at depth 0
+  std::vector<size_t> depth_histogram;
+  // sizeof the nodes, the part of it taken by values, and what the allocator
+  // actually reserved for them
+  size_t node_bytes = 0;
+  size_t payload_bytes = 0;
+  size_t allocated_bytes = 0;
+
+  size_t overhead_bytes() const { return allocated_bytes - payload_bytes; }
+  // share of the reserved memory the nodes do not use
+  double fragmentation() const {
+    return allocated_bytes
+               ? 1.0 - static_cast<double>(node_bytes) / allocated_bytes
+               : 0.0;
+  }
+};
+
+#ifdef S21_RBTREE_STATS
+using DefaultTreeStats = CountingTreeStats;
+#else
+using DefaultTreeStats = NoTreeStats;
+#endif
+}  // namespace s21
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef UNORDERED_MULTISET_H
+#define UNORDERED_MULTISET_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "hash_table.h"
+#include "vector.h"
+
+namespace s21 {
+// unordered_set that keeps equal keys: they sit next to each other in one
+// probe run, in insertion order, so equal_range is a run of adjacent slots.
+//
+// Switching from s21::multiset is not fully mechanical: copies of a key share
+// one probe run, whose length the control bytes cap, so a single key may be
+// stored at most 128 times and one more insert throws std::length_error.
+// The same goes for keys that share one hash value, see unordered_set.
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_multiset : private HashTable<Key, Hash, KeyEqual> {
+ public:
+  using Table = HashTable<Key, Hash, KeyEqual>;
+
+  using key_type = Key;
+  using value_type = Key;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Table::Iterator;
+  using const_iterator = iterator;
+  using size_type = size_t;
+  using node_type = HashNodeHandle<Key>;
+
+  unordered_multiset() = default;
+  explicit unordered_multiset(size_type n) { reserve(n); }
+  unordered_multiset(std::initializer_list<value_type> const &items);
+  unordered_multiset(const unordered_multiset &s) = default;
+  unordered_multiset(unordered_multiset &&s) = default;
+  ~unordered_multiset() = default;
+  unordered_multiset &operator=(const unordered_multiset &s) = default;
+  unordered_multiset &operator=(unordered_multiset &&s) = default;
+
+  iterator begin() const { return this->Begin(); }
+  iterator end() const { return this->End(); }
+
+  bool empty() const { return this->Size() == 0; }
+  size_type size() const { return this->Size(); }
+  size_type max_size() const { return Table::MaxSize(); }
+
+  void clear() { this->Clear(); }
+  iterator insert(const value_type &value) {
+    return insert(value_type(value));
+  }
+  iterator insert(value_type &&value) {
+    return this->At(this->InsertNew(std::move(value), true));
+  }
+  iterator insert(node_type &&nh);
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  // a later insert may move the keys of earlier ones, so the iterators are
+  // looked up once all keys are in and point at the first equal key
+  template <typename... Args>
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
+
+  iterator erase(iterator pos);
+  // erases every key equal to key
+  size_type erase(const key_type &key);
+  node_type extract(iterator pos);
+  node_type extract(const key_type &key);
+  void swap(unordered_multiset &other) { this->Swap(other); }
+  // moves all keys out of other
+  void merge(unordered_multiset &other);
+
+  iterator find(const key_type &key) const { return Wrap(this->Find(key)); }
+  bool contains(const key_type &key) const {
+    return this->Find(key) != Table::npos;
+  }
+  size_type count(const key_type &key) const {
+    auto range = this->EqualRange(key);
+    return range.second - range.first;
+  }
+  std::pair<iterator, iterator> equal_range(const key_type &key) const {
+    auto range = this->EqualRange(key);
+    return std::make_pair(this->At(range.first), this->At(range.second));
+  }
+
+  // lookups by any type the hash and the equality both accept
+  template <typename K>
+    requires requires {
+      typename Hash::is_transparent;
+      typename KeyEqual::is_transparent;
+    }
+  iterator find(const K &key) const {
+    return Wrap(this->Find(key));
+  }
+  template <typename K>
+    requires requires {
+      typename Hash::is_transparent;
+      typename KeyEqual::is_transparent;
+    }
+  bool contains(const K &key) const {
+    return this->Find(key) != Table::npos;
+  }
+  template <typename K>
+    requires requires {
+      typename Hash::is_transparent;
+      typename KeyEqual::is_transparent;
+    }
+  size_type count(const K &key) const {
+    auto range = this->EqualRange(key);
+    return range.second - range.first;
+  }
+
+  size_type bucket_count() const { return this->Buckets(); }
+  float load_factor() const {
+    return bucket_count() ? static_cast<float>(size()) / bucket_count() : 0;
+  }
+  float max_load_factor() const { return 0.8f; }
+  // room for n keys without growing
+  void reserve(size_type n) { this->Reserve(n); }
+  void rehash(size_type n);
+  hasher hash_function() const { return this->GetHash(); }
+  key_equal key_eq() const { return this->GetKeyEqual(); }
+
+  bool validate() const { return this->Validate(); }
+  // slots a lookup of the worst placed key looks at
+  size_type max_probe() const { return this->MaxProbe(); }
+
+ private:
+  iterator Wrap(size_t i) const {
+    return i == Table::npos ? end() : this->At(i);
+  }
+};
+}  // namespace s21
+
+#include "unordered_multiset.tpp"
+
+#endif
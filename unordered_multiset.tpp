@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <bit>
+
+#include "unordered_multiset.h"
+
+template <typename Key, typename Hash, typename KeyEqual>
+s21::unordered_multiset<Key, Hash, KeyEqual>::unordered_multiset(
+    std::initializer_list<value_type> const &items) {
+  reserve(items.size());
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_multiset<Key, Hash, KeyEqual>::iterator
+s21::unordered_multiset<Key, Hash, KeyEqual>::insert(node_type &&nh) {
+  if (nh.empty()) {
+    return end();
+  }
+  iterator res = insert(std::move(nh.value()));
+  nh.Reset();
+  return res;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename... Args>
+s21::vector<std::pair<typename s21::unordered_multiset<Key, Hash,
+                                                      KeyEqual>::iterator,
+                      bool>,
+            sizeof...(Args)>
+s21::unordered_multiset<Key, Hash, KeyEqual>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
+  value_type values[] = {value_type(std::forward<Args>(args))...};
+
+  reserve(size() + sizeof...(Args));
+  for (const auto &value : values) {
+    insert(value);
+  }
+  for (const auto &value : values) {
+    results.push_back(std::make_pair(find(value), true));
+  }
+
+  return results;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_multiset<Key, Hash, KeyEqual>::iterator
+s21::unordered_multiset<Key, Hash, KeyEqual>::erase(iterator pos) {
+  size_t i = this->IndexOf(pos);
+  this->EraseAt(i);
+  // the next key of the run has shifted into slot i
+  return this->Next(i);
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_multiset<Key, Hash, KeyEqual>::size_type
+s21::unordered_multiset<Key, Hash, KeyEqual>::erase(const key_type &key) {
+  auto range = this->EqualRange(key);
+  // each erase shifts the next equal key into the first slot
+  for (size_t i = range.first; i < range.second; ++i) {
+    this->EraseAt(range.first);
+  }
+  return range.second - range.first;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_multiset<Key, Hash, KeyEqual>::node_type
+s21::unordered_multiset<Key, Hash, KeyEqual>::extract(iterator pos) {
+  size_t i = this->IndexOf(pos);
+  node_type nh(std::move(this->SlotAt(i)));
+  this->EraseAt(i);
+  return nh;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_multiset<Key, Hash, KeyEqual>::node_type
+s21::unordered_multiset<Key, Hash, KeyEqual>::extract(const key_type &key) {
+  size_t i = this->Find(key);
+  return i == Table::npos ? node_type() : extract(this->At(i));
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+void s21::unordered_multiset<Key, Hash, KeyEqual>::merge(
+    unordered_multiset &other) {
+  if (this == &other) {
+    return;
+  }
+  reserve(size() + other.size());
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    this->InsertNew(std::move(other.SlotAt(other.IndexOf(it))), true);
+  }
+  other.clear();
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+void s21::unordered_multiset<Key, Hash, KeyEqual>::rehash(size_type n) {
+  // the table grows again on its own if n is too small for the keys
+  this->Rehash(std::bit_ceil(std::max<size_type>(n, Table::kMinBuckets)));
+}
@@ -0,0 +1,141 @@
+#ifndef UNORDERED_SET_H
+#define UNORDERED_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "hash_table.h"
+#include "vector.h"
+
+namespace s21 {
+// Set without ordering for call sites that only insert, erase and look keys
+// up: one hash and a short run of adjacent slots per lookup instead of a
+// descent through log n nodes. The interface follows s21::set, minus the
+// ordered queries.
+//
+// Inserting or erasing may move other keys between slots, so iterators stay
+// valid only until the next modification; erase returns the next key.
+//
+// Keys with equal hashes share one probe run, which holds at most 255 keys:
+// an insert that would need more throws std::length_error rather than
+// growing the table without end, so a weak or attacker-chosen hash fails
+// fast where std::unordered_set would slow down.
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class unordered_set : private HashTable<Key, Hash, KeyEqual> {
+ public:
+  using Table = HashTable<Key, Hash, KeyEqual>;
+
+  using key_type = Key;
+  using value_type = Key;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename Table::Iterator;
+  using const_iterator = iterator;
+  using size_type = size_t;
+  using node_type = HashNodeHandle<Key>;
+
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
+  unordered_set() = default;
+  explicit unordered_set(size_type n) { reserve(n); }
+  unordered_set(std::initializer_list<value_type> const &items);
+  unordered_set(const unordered_set &s) = default;
+  unordered_set(unordered_set &&s) = default;
+  ~unordered_set() = default;
+  unordered_set &operator=(const unordered_set &s) = default;
+  unordered_set &operator=(unordered_set &&s) = default;
+
+  iterator begin() const { return this->Begin(); }
+  iterator end() const { return this->End(); }
+
+  bool empty() const { return this->Size() == 0; }
+  size_type size() const { return this->Size(); }
+  size_type max_size() const { return Table::MaxSize(); }
+
+  void clear() { this->Clear(); }
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return Wrap(this->InsertUnique(value));
+  }
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return Wrap(this->InsertUnique(std::move(value)));
+  }
+  insert_return_type insert(node_type &&nh);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+  // a later insert may move the keys of earlier ones, so the iterators are
+  // looked up once all keys are in
+  template <typename... Args>
+  vector<std::pair<iterator, bool>, sizeof...(Args)> insert_many(
+      Args &&...args);
+
+  iterator erase(iterator pos);
+  size_type erase(const key_type &key);
+  node_type extract(iterator pos);
+  node_type extract(const key_type &key);
+  void swap(unordered_set &other) { this->Swap(other); }
+  // moves the keys missing here out of other
+  void merge(unordered_set &other);
+
+  iterator find(const key_type &key) const { return Wrap(this->Find(key)); }
+  bool contains(const key_type &key) const {
+    return this->Find(key) != Table::npos;
+  }
+  size_type count(const key_type &key) const { return contains(key); }
+
+  // lookups by any type the hash and the equality both accept
+  template <typename K>
+    requires requires {
+      typename Hash::is_transparent;
+      typename KeyEqual::is_transparent;
+    }
+  iterator find(const K &key) const {
+    return Wrap(this->Find(key));
+  }
+  template <typename K>
+    requires requires {
+      typename Hash::is_transparent;
+      typename KeyEqual::is_transparent;
+    }
+  bool contains(const K &key) const {
+    return this->Find(key) != Table::npos;
+  }
+
+  size_type bucket_count() const { return this->Buckets(); }
+  float load_factor() const {
+    return bucket_count() ? static_cast<float>(size()) / bucket_count() : 0;
+  }
+  float max_load_factor() const { return 0.8f; }
+  // room for n keys without growing
+  void reserve(size_type n) { this->Reserve(n); }
+  void rehash(size_type n);
+  hasher hash_function() const { return this->GetHash(); }
+  key_equal key_eq() const { return this->GetKeyEqual(); }
+
+  bool validate() const { return this->Validate(); }
+  // slots a lookup of the worst placed key looks at
+  size_type max_probe() const { return this->MaxProbe(); }
+
+ private:
+  iterator Wrap(size_t i) const {
+    return i == Table::npos ? end() : this->At(i);
+  }
+  std::pair<iterator, bool> Wrap(std::pair<size_t, bool> res) const {
+    return std::make_pair(this->At(res.first), res.second);
+  }
+};
+}  // namespace s21
+
+#include "unordered_set.tpp"
+
+#endif
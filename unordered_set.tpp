@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <bit>
+
+#include "unordered_set.h"
+
+template <typename Key, typename Hash, typename KeyEqual>
+s21::unordered_set<Key, Hash, KeyEqual>::unordered_set(
+    std::initializer_list<value_type> const &items) {
+  reserve(items.size());
+  for (const auto &item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_set<Key, Hash, KeyEqual>::insert_return_type
+s21::unordered_set<Key, Hash, KeyEqual>::insert(node_type &&nh) {
+  insert_return_type res{end(), false, node_type()};
+
+  if (!nh.empty()) {
+    auto pos = this->FindUniquePos(nh.value());
+    if (pos.found_ != Table::npos) {
+      res.position = this->At(pos.found_);
+      res.node = std::move(nh);
+    } else {
+      res.position = this->At(this->InsertNew(std::move(nh.value()), false));
+      res.inserted = true;
+      nh.Reset();
+    }
+  }
+
+  return res;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+template <typename... Args>
+s21::vector<
+    std::pair<typename s21::unordered_set<Key, Hash, KeyEqual>::iterator, bool>,
+    sizeof...(Args)>
+s21::unordered_set<Key, Hash, KeyEqual>::insert_many(Args &&...args) {
+  vector<std::pair<iterator, bool>, sizeof...(Args)> results;
+  value_type values[] = {value_type(std::forward<Args>(args))...};
+
+  reserve(size() + sizeof...(Args));
+  for (const auto &value : values) {
+    results.push_back(std::make_pair(end(), insert(value).second));
+  }
+  for (size_t i = 0; i < sizeof...(Args); ++i) {
+    results[i].first = find(values[i]);
+  }
+
+  return results;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_set<Key, Hash, KeyEqual>::iterator
+s21::unordered_set<Key, Hash, KeyEqual>::erase(iterator pos) {
+  size_t i = this->IndexOf(pos);
+  this->EraseAt(i);
+  // the next key of the run has shifted into slot i
+  return this->Next(i);
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_set<Key, Hash, KeyEqual>::size_type
+s21::unordered_set<Key, Hash, KeyEqual>::erase(const key_type &key) {
+  size_t i = this->Find(key);
+  if (i == Table::npos) {
+    return 0;
+  }
+  this->EraseAt(i);
+  return 1;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_set<Key, Hash, KeyEqual>::node_type
+s21::unordered_set<Key, Hash, KeyEqual>::extract(iterator pos) {
+  size_t i = this->IndexOf(pos);
+  node_type nh(std::move(this->SlotAt(i)));
+  this->EraseAt(i);
+  return nh;
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+typename s21::unordered_set<Key, Hash, KeyEqual>::node_type
+s21::unordered_set<Key, Hash, KeyEqual>::extract(const key_type &key) {
+  size_t i = this->Find(key);
+  return i == Table::npos ? node_type() : extract(this->At(i));
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+void s21::unordered_set<Key, Hash, KeyEqual>::merge(unordered_set &other) {
+  if (this == &other) {
+    return;
+  }
+  iterator it = other.begin();
+  while (it != other.end()) {
+    size_t i = other.IndexOf(it);
+    if (contains(*it)) {
+      ++it;
+    } else {
+      this->InsertNew(std::move(other.SlotAt(i)), false);
+      other.EraseAt(i);
+      it = other.Next(i);
+    }
+  }
+}
+
+template <typename Key, typename Hash, typename KeyEqual>
+void s21::unordered_set<Key, Hash, KeyEqual>::rehash(size_type n) {
+  // the table grows again on its own if n is too small for the keys
+  this->Rehash(std::bit_ceil(std::max<size_type>(n, Table::kMinBuckets)));
+}
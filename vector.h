@@ -0,0 +1,141 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// Types whose objects may be moved to another address with memcpy and
+// without running the destructor on the old copy. Trivially copyable types
+// always qualify; specialize for others that hold no self pointers.
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+template <typename T, size_t N>
+struct VectorInlineStorage {
+  T *Data() { return reinterpret_cast<T *>(bytes_); }
+  alignas(T) unsigned char bytes_[N * sizeof(T)];
+};
+
+template <typename T>
+struct VectorInlineStorage<T, 0> {
+  T *Data() { return nullptr; }
+};
+
+// Dynamic array that keeps up to N elements inside the object, so short
+// vectors never touch the heap. Capacity doubles on growth; trivially
+// relocatable elements are moved to the new buffer with one memcpy, others
+// are move constructed (copied when the move may throw).
+template <typename T, size_t N = 0>
+class vector {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using size_type = size_t;
+
+  static constexpr size_type inline_capacity = N;
+
+  vector() = default;
+  explicit vector(size_type n);
+  vector(std::initializer_list<value_type> const &items);
+  vector(const vector &v);
+  vector(vector &&v) noexcept(is_trivially_relocatable_v<T> ||
+                              std::is_nothrow_move_constructible_v<T>);
+  ~vector();
+
+  vector &operator=(const vector &v);
+  vector &operator=(vector &&v) noexcept(
+      is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>);
+
+  // throws std::out_of_range when pos is not below size()
+  reference at(size_type pos);
+  const_reference at(size_type pos) const;
+  reference operator[](size_type pos) { return data_[pos]; }
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+  reference front() { return data_[0]; }
+  const_reference front() const { return data_[0]; }
+  reference back() { return data_[size_ - 1]; }
+  const_reference back() const { return data_[size_ - 1]; }
+  T *data() { return data_; }
+  const T *data() const { return data_; }
+
+  iterator begin() { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+  void reserve(size_type size);
+  size_type capacity() const { return capacity_; }
+  // gives the heap buffer back, moving into the inline one when it fits
+  void shrink_to_fit();
+  // true while the elements live inside the object
+  bool is_inline() const { return N && data_ == InlineData(); }
+
+  void clear();
+  iterator insert(const_iterator pos, const_reference value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+  }
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args);
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last);
+  void push_back(const_reference value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  template <typename... Args>
+  reference emplace_back(Args &&...args);
+  void pop_back();
+  void swap(vector &other);
+
+  // inserts the values before pos in their order, returns the first of them
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args);
+  template <typename... Args>
+  void insert_many_back(Args &&...args);
+
+  bool operator==(const vector &other) const;
+  bool operator!=(const vector &other) const { return !(*this == other); }
+
+ private:
+  T *InlineData() const {
+    return const_cast<VectorInlineStorage<T, N> &>(inline_).Data();
+  }
+  size_type GrowTo(size_type needed) const;
+  // moves the elements into a buffer of the given capacity
+  void Reallocate(size_type capacity);
+  static void Relocate(T *from, size_type n, T *to);
+  // takes the elements of other, which is left empty
+  void Steal(vector &other);
+  void Release();
+
+  T *data_ = InlineData();
+  size_type size_ = 0;
+  size_type capacity_ = N;
+  [[no_unique_address]] VectorInlineStorage<T, N> inline_;
+};
+}  // namespace s21
+
+#include "vector.tpp"
+
+#endif
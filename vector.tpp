@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "vector.h"
+
+template <typename T, size_t N>
+s21::vector<T, N>::vector(size_type n) {
+  reserve(n);
+  std::uninitialized_value_construct_n(data_, n);
+  size_ = n;
+}
+
+template <typename T, size_t N>
+s21::vector<T, N>::vector(std::initializer_list<value_type> const &items) {
+  reserve(items.size());
+  std::uninitialized_copy(items.begin(), items.end(), data_);
+  size_ = items.size();
+}
+
+template <typename T, size_t N>
+s21::vector<T, N>::vector(const vector &v) {
+  reserve(v.size_);
+  std::uninitialized_copy(v.begin(), v.end(), data_);
+  size_ = v.size_;
+}
+
+template <typename T, size_t N>
+s21::vector<T, N>::vector(vector &&v) noexcept(
+    is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+  Steal(v);
+}
+
+template <typename T, size_t N>
+s21::vector<T, N>::~vector() {
+  clear();
+  Release();
+}
+
+template <typename T, size_t N>
+s21::vector<T, N> &s21::vector<T, N>::operator=(const vector &v) {
+  if (this != &v) {
+    clear();
+    reserve(v.size_);
+    std::uninitialized_copy(v.begin(), v.end(), data_);
+    size_ = v.size_;
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+s21::vector<T, N> &s21::vector<T, N>::operator=(vector &&v) noexcept(
+    is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+  if (this != &v) {
+    clear();
+    Release();
+    Steal(v);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+typename s21::vector<T, N>::reference s21::vector<T, N>::at(size_type pos) {
+  if (pos >= size_) {
+    throw std::out_of_range("vector::at: index out of range");
+  }
+  return data_[pos];
+}
+
+template <typename T, size_t N>
+typename s21::vector<T, N>::const_reference s21::vector<T, N>::at(
+    size_type pos) const {
+  if (pos >= size_) {
+    throw std::out_of_range("vector::at: index out of range");
+  }
+  return data_[pos];
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::reserve(size_type size) {
+  if (size > capacity_) {
+    if (size > max_size()) {
+      throw std::length_error("vector::reserve: size exceeds max_size");
+    }
+    Reallocate(size);
+  }
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::shrink_to_fit() {
+  if (data_ != InlineData() && capacity_ > size_) {
+    Reallocate(size_);
+  }
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::clear() {
+  std::destroy_n(data_, size_);
+  size_ = 0;
+}
+
+// the new value is built before any element moves, so args may refer into
+// the vector itself
+template <typename T, size_t N>
+template <typename... Args>
+typename s21::vector<T, N>::iterator s21::vector<T, N>::emplace(
+    const_iterator pos, Args &&...args) {
+  size_type idx = pos - data_;
+  if (idx == size_) {
+    emplace_back(std::forward<Args>(args)...);
+    return data_ + idx;
+  }
+
+  T value(std::forward<Args>(args)...);
+  if (size_ == capacity_) {
+    Reallocate(GrowTo(size_ + 1));
+  }
+  T *slot = data_ + idx;
+  if constexpr (is_trivially_relocatable_v<T>) {
+    std::memmove(static_cast<void *>(slot + 1), static_cast<void *>(slot),
+                 (size_ - idx) * sizeof(T));
+    ::new (static_cast<void *>(slot)) T(std::move(value));
+  } else {
+    ::new (static_cast<void *>(data_ + size_)) T(std::move(data_[size_ - 1]));
+    std::move_backward(slot, data_ + size_ - 1, data_ + size_);
+    *slot = std::move(value);
+  }
+  ++size_;
+
+  return slot;
+}
+
+template <typename T, size_t N>
+typename s21::vector<T, N>::iterator s21::vector<T, N>::erase(
+    const_iterator first, const_iterator last) {
+  T *from = data_ + (first - data_);
+  size_type n = last - first;
+  if (n) {
+    std::move(from + n, end(), from);
+    std::destroy_n(end() - n, n);
+    size_ -= n;
+  }
+  return from;
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+typename s21::vector<T, N>::reference s21::vector<T, N>::emplace_back(
+    Args &&...args) {
+  if (size_ < capacity_) {
+    ::new (static_cast<void *>(data_ + size_)) T(std::forward<Args>(args)...);
+  } else {
+    // the new element goes in first, args may refer to the old buffer
+    size_type capacity = GrowTo(size_ + 1);
+    T *fresh = std::allocator<T>().allocate(capacity);
+    bool built = false;
+    try {
+      ::new (static_cast<void *>(fresh + size_))
+          T(std::forward<Args>(args)...);
+      built = true;
+      Relocate(data_, size_, fresh);
+    } catch (...) {
+      if (built) {
+        std::destroy_at(fresh + size_);
+      }
+      std::allocator<T>().deallocate(fresh, capacity);
+      throw;
+    }
+    Release();
+    data_ = fresh;
+    capacity_ = capacity;
+  }
+  ++size_;
+
+  return back();
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::pop_back() {
+  --size_;
+  std::destroy_at(data_ + size_);
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::swap(vector &other) {
+  if (this == &other) {
+    return;
+  }
+  if (data_ != InlineData() && other.data_ != other.InlineData()) {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+  } else {
+    vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+typename s21::vector<T, N>::iterator s21::vector<T, N>::insert_many(
+    const_iterator pos, Args &&...args) {
+  size_type idx = pos - data_;
+  size_type old_size = size_;
+  insert_many_back(std::forward<Args>(args)...);
+  std::rotate(data_ + idx, data_ + old_size, end());
+  return data_ + idx;
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+void s21::vector<T, N>::insert_many_back(Args &&...args) {
+  if (size_ + sizeof...(Args) <= capacity_) {
+    (emplace_back(std::forward<Args>(args)), ...);
+    return;
+  }
+  // as in emplace_back the new elements go in first, args may refer to the
+  // old buffer
+  size_type capacity = GrowTo(size_ + sizeof...(Args));
+  T *fresh = std::allocator<T>().allocate(capacity);
+  size_type built = 0;
+  try {
+    ((::new (static_cast<void *>(fresh + size_ + built))
+          T(std::forward<Args>(args)),
+      ++built),
+     ...);
+    Relocate(data_, size_, fresh);
+  } catch (...) {
+    std::destroy_n(fresh + size_, built);
+    std::allocator<T>().deallocate(fresh, capacity);
+    throw;
+  }
+  Release();
+  data_ = fresh;
+  capacity_ = capacity;
+  size_ += built;
+}
+
+template <typename T, size_t N>
+bool s21::vector<T, N>::operator==(const vector &other) const {
+  return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+}
+
+template <typename T, size_t N>
+typename s21::vector<T, N>::size_type s21::vector<T, N>::GrowTo(
+    size_type needed) const {
+  if (needed > max_size()) {
+    throw std::length_error("vector: size exceeds max_size");
+  }
+  size_type res = capacity_ ? capacity_ * 2 : 4;
+  if (res < needed || res > max_size()) {
+    res = needed;
+  }
+  return res;
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::Reallocate(size_type capacity) {
+  T *fresh = capacity > N ? std::allocator<T>().allocate(capacity)
+                          : InlineData();
+  try {
+    Relocate(data_, size_, fresh);
+  } catch (...) {
+    if (capacity > N) {
+      std::allocator<T>().deallocate(fresh, capacity);
+    }
+    throw;
+  }
+  Release();
+  data_ = fresh;
+  capacity_ = capacity > N ? capacity : N;
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::Relocate(T *from, size_type n, T *to) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if (n) {
+      std::memcpy(static_cast<void *>(to), static_cast<void *>(from),
+                  n * sizeof(T));
+    }
+  } else {
+    // a throwing copy leaves from as it was and nothing built in to
+    size_type i = 0;
+    try {
+      for (; i < n; ++i) {
+        ::new (static_cast<void *>(to + i)) T(std::move_if_noexcept(from[i]));
+      }
+    } catch (...) {
+      std::destroy_n(to, i);
+      throw;
+    }
+    std::destroy_n(from, n);
+  }
+}
+
+template <typename T, size_t N>
+void s21::vector<T, N>::Steal(vector &other) {
+  if (other.data_ != other.InlineData()) {
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+    other.data_ = other.InlineData();
+    other.capacity_ = N;
+  } else {
+    Relocate(other.data_, other.size_, data_);
+  }
+  size_ = other.size_;
+  other.size_ = 0;
+}
+
+// frees a heap buffer without touching the elements
+template <typename T, size_t N>
+void s21::vector<T, N>::Release() {
+  if (data_ != InlineData()) {
+    std::allocator<T>().deallocate(data_, capacity_);
+    data_ = InlineData();
+    capacity_ = N;
+  }
+}